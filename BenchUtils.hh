@@ -0,0 +1,507 @@
+/*
+ * BenchUtils.hh
+ *
+ * Simple benchmarking framework, in the spirit of TestUtils.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <list>
+#include <sstream>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdint.h>
+#include <string.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace bench_utils {
+
+/**
+ * Simple wall clock timer, started when constructed
+ */
+class Timer
+{
+public:
+  Timer() : start_(chrono::steady_clock::now()) {}
+  void restart() { start_ = chrono::steady_clock::now(); }
+  double elapsedNs() const
+  {
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start_).count();
+  }
+private:
+  chrono::steady_clock::time_point start_;
+};
+
+/**
+ * The results are logged as readable text, as CSV, or as JSON with one object per line
+ */
+enum OutputFormat
+{
+  OUTPUT_TEXT,
+  OUTPUT_CSV,
+  OUTPUT_JSON
+};
+
+OutputFormat &outputFormat()
+{
+  static OutputFormat format(OUTPUT_TEXT);
+  return format;
+}
+
+/**
+ * One logged measurement, for the CSV and JSON output. Negative fields don't apply to it.
+ */
+struct Record
+{
+  Record(const string &bench, const string &variant) :
+    bench_(bench), variant_(variant), ops_(-1), nsPerOp_(-1), mopsPerSec_(-1),
+    samples_(-1), p50Ns_(-1), p99Ns_(-1), maxNs_(-1), peakRssKb_(-1), insnPerOp_(-1), bytesPerElement_(-1), mbPerSec_(-1)
+  {
+  }
+  string bench_;
+  string variant_;
+  int64_t ops_;
+  double nsPerOp_;
+  double mopsPerSec_;
+  int64_t samples_;
+  double p50Ns_;
+  double p99Ns_;
+  double maxNs_;
+  int64_t peakRssKb_;
+  double insnPerOp_;
+  double bytesPerElement_;
+  double mbPerSec_;
+};
+
+/**
+ * Internal method to quote a string for the CSV or JSON output
+ */
+string quote(const string &value)
+{
+  string quoted("\"");
+  for(size_t i = 0; i < value.size(); ++i)
+  {
+    if(value[i] == '"')
+    {
+      quoted += (outputFormat() == OUTPUT_CSV ? "\"\"" : "\\\"");
+    }
+    else if(value[i] == '\\' && outputFormat() == OUTPUT_JSON)
+    {
+      quoted += "\\\\";
+    }
+    else
+    {
+      quoted += value[i];
+    }
+  }
+
+  return quoted + "\"";
+}
+
+/**
+ * Internal method to add one field to a CSV or JSON line, empty or left out if it's negative
+ */
+template <class Value>
+void addField(ostringstream &line, const string &name, Value value)
+{
+  if(outputFormat() == OUTPUT_CSV)
+  {
+    line << ",";
+    if(value >= 0)
+    {
+      line << value;
+    }
+  }
+  else if(value >= 0)
+  {
+    line << ", \"" << name << "\": " << value;
+  }
+}
+
+/**
+ * Log the column names, only needed for the CSV output
+ */
+void logHeader()
+{
+  if(outputFormat() == OUTPUT_CSV)
+  {
+    cout << "bench,variant,ops,ns_per_op,mops_per_s,samples,p50_ns,p99_ns,max_ns,peak_rss_kb,insn_per_op,bytes_per_element,mb_per_s" << endl;
+  }
+}
+
+/**
+ * Log a measurement as a CSV or JSON line
+ */
+void logRecord(const Record &record)
+{
+  ostringstream line;
+  line << fixed << setprecision(2);
+  if(outputFormat() == OUTPUT_CSV)
+  {
+    line << quote(record.bench_) << "," << quote(record.variant_);
+  }
+  else
+  {
+    line << "{\"bench\": " << quote(record.bench_) << ", \"variant\": " << quote(record.variant_);
+  }
+
+  addField(line, "ops", record.ops_);
+  addField(line, "ns_per_op", record.nsPerOp_);
+  addField(line, "mops_per_s", record.mopsPerSec_);
+  addField(line, "samples", record.samples_);
+  addField(line, "p50_ns", record.p50Ns_);
+  addField(line, "p99_ns", record.p99Ns_);
+  addField(line, "max_ns", record.maxNs_);
+  addField(line, "peak_rss_kb", record.peakRssKb_);
+  addField(line, "insn_per_op", record.insnPerOp_);
+  addField(line, "bytes_per_element", record.bytesPerElement_);
+  addField(line, "mb_per_s", record.mbPerSec_);
+
+  if(outputFormat() == OUTPUT_JSON)
+  {
+    line << "}";
+  }
+  cout << line.str() << endl;
+}
+
+/**
+ * Log the result of a measurement of ops operations that took ns nanoseconds
+ */
+void logResult(const string &bench, const string &variant, uint64_t ops, double ns)
+{
+  double nsPerOp(ops == 0 ? 0.0 : ns / ops);
+  double mopsPerSec(ns == 0 ? 0.0 : ops * 1000.0 / ns);
+
+  if(outputFormat() != OUTPUT_TEXT)
+  {
+    Record record(bench, variant);
+    record.ops_ = ops;
+    record.nsPerOp_ = nsPerOp;
+    record.mopsPerSec_ = mopsPerSec;
+    logRecord(record);
+    return;
+  }
+
+  cout << "Bench: " << bench << ", " << variant
+       << ", ops=" << ops
+       << ", ns/op=" << fixed << setprecision(2) << nsPerOp
+       << ", Mops/s=" << mopsPerSec
+       << endl;
+}
+
+/**
+ * Log the p50, p99 and max of latency samples given in nanoseconds
+ */
+void logLatency(const string &bench, const string &variant, vector<double> &samples)
+{
+  if(samples.empty())
+  {
+    return;
+  }
+
+  sort(samples.begin(), samples.end());
+  if(outputFormat() != OUTPUT_TEXT)
+  {
+    Record record(bench, variant);
+    record.samples_ = samples.size();
+    record.p50Ns_ = samples[samples.size() / 2];
+    record.p99Ns_ = samples[(samples.size() * 99) / 100];
+    record.maxNs_ = samples.back();
+    logRecord(record);
+    return;
+  }
+
+  cout << "Bench: " << bench << ", " << variant
+       << ", samples=" << samples.size()
+       << ", p50 ns=" << fixed << setprecision(0) << samples[samples.size() / 2]
+       << ", p99 ns=" << samples[(samples.size() * 99) / 100]
+       << ", max ns=" << samples.back()
+       << setprecision(2) << endl;
+}
+
+/**
+ * Log the peak resident memory, in KB, used by a benchmark
+ */
+void logMemory(const string &bench, const string &variant, int64_t peakRssKb)
+{
+  if(outputFormat() != OUTPUT_TEXT)
+  {
+    Record record(bench, variant);
+    record.peakRssKb_ = peakRssKb;
+    logRecord(record);
+    return;
+  }
+
+  cout << "Bench: " << bench << ", " << variant << ", peak RSS KB=" << peakRssKb << endl;
+}
+
+/**
+ * Log the number of instructions per operation of a measurement of ops operations
+ */
+void logInstructions(const string &bench, const string &variant, uint64_t ops, int64_t instructions)
+{
+  double insnPerOp(ops == 0 ? 0.0 : double(instructions) / ops);
+  if(outputFormat() != OUTPUT_TEXT)
+  {
+    Record record(bench, variant);
+    record.ops_ = ops;
+    record.insnPerOp_ = insnPerOp;
+    logRecord(record);
+    return;
+  }
+
+  cout << "Bench: " << bench << ", " << variant
+       << ", ops=" << ops
+       << ", insn/op=" << fixed << setprecision(2) << insnPerOp
+       << endl;
+}
+
+/**
+ * Log the result of a measurement of ops operations on bytes bytes that took ns nanoseconds,
+ * with the throughput in MB/s, 1MB being 10^6 bytes
+ */
+void logThroughput(const string &bench, const string &variant, uint64_t ops, double ns, uint64_t bytes)
+{
+  double nsPerOp(ops == 0 ? 0.0 : ns / ops);
+  double mopsPerSec(ns == 0 ? 0.0 : ops * 1000.0 / ns);
+  double mbPerSec(ns == 0 ? 0.0 : bytes * 1000.0 / ns);
+
+  if(outputFormat() != OUTPUT_TEXT)
+  {
+    Record record(bench, variant);
+    record.ops_ = ops;
+    record.nsPerOp_ = nsPerOp;
+    record.mopsPerSec_ = mopsPerSec;
+    record.mbPerSec_ = mbPerSec;
+    logRecord(record);
+    return;
+  }
+
+  cout << "Bench: " << bench << ", " << variant
+       << ", ops=" << ops
+       << ", ns/op=" << fixed << setprecision(2) << nsPerOp
+       << ", Mops/s=" << mopsPerSec
+       << ", MB/s=" << mbPerSec
+       << endl;
+}
+
+/**
+ * Log the memory used per element by a container of elements elements using bytes bytes
+ */
+void logFootprint(const string &bench, const string &variant, uint64_t elements, int64_t bytes)
+{
+  double bytesPerElement(elements == 0 ? 0.0 : double(bytes) / elements);
+  if(outputFormat() != OUTPUT_TEXT)
+  {
+    Record record(bench, variant);
+    record.bytesPerElement_ = bytesPerElement;
+    logRecord(record);
+    return;
+  }
+
+  cout << "Bench: " << bench << ", " << variant
+       << ", bytes/element=" << fixed << setprecision(2) << bytesPerElement
+       << endl;
+}
+
+/**
+ * Count the user space instructions retired between start() and stop(),
+ * with perf_event_open(). Not available when the hardware counters can't
+ * be used, like in most virtual machines and containers.
+ */
+class InstructionCounter
+{
+public:
+  InstructionCounter() : fd_(-1)
+  {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+
+  ~InstructionCounter()
+  {
+    if(fd_ >= 0)
+    {
+      close(fd_);
+    }
+  }
+
+  bool available() const { return fd_ >= 0; }
+
+  void start()
+  {
+    if(fd_ >= 0)
+    {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+
+  /**
+   * Return the number of instructions since start(), or -1 if not available
+   */
+  int64_t stop()
+  {
+    int64_t count(-1);
+    if(fd_ >= 0)
+    {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if(read(fd_, &count, sizeof(count)) != sizeof(count))
+      {
+        count = -1;
+      }
+    }
+    return count;
+  }
+
+private:
+  InstructionCounter(const InstructionCounter &);
+  InstructionCounter &operator=(const InstructionCounter &);
+
+  int fd_;
+};
+
+/**
+ * Return the current resident memory of the process in KB, or -1 if unknown
+ */
+int64_t currentRssKb()
+{
+  long pages(-1);
+  long resident(-1);
+  FILE *statm(fopen("/proc/self/statm", "r"));
+  if(statm == NULL)
+  {
+    return -1;
+  }
+  if(fscanf(statm, "%ld %ld", &pages, &resident) != 2)
+  {
+    resident = -1;
+  }
+  fclose(statm);
+
+  return resident < 0 ? -1 : int64_t(resident) * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+/**
+ * Return the peak resident memory of the process in KB
+ */
+int64_t peakRssKb()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * Run body in a forked child process, then log how much its peak resident memory
+ * grew over the memory inherited from this process. Each body is isolated from
+ * the memory used by the previous ones. If fork() fails, body runs in this process
+ * and the memory isn't logged.
+ */
+void runIsolated(const string &bench, const string &variant, const function<void()> &body)
+{
+  cout.flush();
+  pid_t pid(fork());
+  if(pid < 0)
+  {
+    body();
+    return;
+  }
+
+  if(pid == 0)
+  {
+    int status(0);
+    try
+    {
+      int64_t startKb(currentRssKb());
+      body();
+      logMemory(bench, variant, peakRssKb() - startKb);
+    }
+    catch(std::exception &e)
+    {
+      cout << "Bench Failure: " << bench << ", " << variant << ", " << e.what() << endl;
+      status = 1;
+    }
+    cout.flush();
+    _exit(status);
+  }
+
+  int status;
+  waitpid(pid, &status, 0);
+}
+
+/**
+ * Return a monotonic timestamp in nanoseconds
+ */
+int64_t nowNs()
+{
+  return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Prevent the compiler from optimizing away a computed value
+ */
+template <class T>
+void doNotOptimize(const T &value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+typedef void (*BENCH_FUNC_POINTER)();
+
+struct BenchCase
+{
+  BenchCase(const string &name, BENCH_FUNC_POINTER bench) : bench_(bench)
+  {
+    benchName_ = (name[0] == '&' ? name.substr(1) : name);
+  }
+  string benchName_;
+  BENCH_FUNC_POINTER bench_;
+};
+
+typedef list<BenchCase> BenchCaseList;
+
+#define ADD_BENCH(bench, benchList) { bench_utils::BenchCase bc(#bench, bench); benchList.push_back(bc); }
+
+/**
+ * Execute the benchmark if its name contains filter
+ */
+void executeBench(BenchCase &bc, const string &filter)
+{
+  if(bc.benchName_.find(filter) == string::npos)
+  {
+    return;
+  }
+
+  try
+  {
+    (bc.bench_)();
+  }
+  catch(std::exception &e)
+  {
+    cout << "Bench Failure: " << bc.benchName_ << ", " << e.what() << endl;
+  }
+}
+
+};
@@ -0,0 +1,445 @@
+/*
+ * CompactLinkedList.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef COMPACTLINKEDLIST_HH_
+#define COMPACTLINKEDLIST_HH_
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <stdint.h>
+
+#include "ListPolicies.hh"
+
+/**
+ * A compact single LinkedList: the nodes live in one contiguous array,
+ * which is its own node pool, and link to each other with 32-bit indices
+ * instead of 64-bit pointers. A list can't hold more than 2^32 - 1 nodes
+ * anyway, since its size is 32 bits. For small elements like ints, a node
+ * takes half the memory of a SimpleLinkedList node, and there's no
+ * allocation overhead per node. It has the same interface as the
+ * SimpleLinkedList, but the array grows by doubling: it's reallocated,
+ * and the elements moved, like in an std::vector. The iterators keep
+ * indices, so they stay valid when the array grows.
+ */
+template <class T>
+class CompactLinkedList
+{
+private:
+  /**
+   * Internal class used to store the data in the Linked List
+   */
+  struct ListNode
+  {
+    template <class... Args>
+    ListNode(uint32_t next, Args&&... args) : data_(std::forward<Args>(args)...), next_(next) {}
+    T data_;
+    uint32_t next_;
+  };
+
+  /**
+   * Internal storage for one node. Free slots store the index of the next free slot instead.
+   */
+  typedef typename std::aligned_storage<sizeof(ListNode), alignof(ListNode)>::type Slot;
+  static_assert(alignof(Slot) <= alignof(std::max_align_t), "over-aligned nodes are not supported");
+
+  /**
+   * The index used as a NULL link
+   */
+  static const uint32_t NIL = 0xFFFFFFFF;
+
+  /**
+   * Internal class used to iterate the Linked List
+   */
+  class ListIterator
+  {
+  public:
+    ListIterator() : list_(NULL), index_(NIL) {}
+    ListIterator(CompactLinkedList *list, uint32_t index) : list_(list), index_(index) {}
+    bool operator==(ListIterator rhs) const { return rhs.index_ == index_; }
+    bool operator!=(ListIterator rhs) const { return rhs.index_ != index_; }
+    T * operator->() const { return &(list_->node(index_)->data_); }
+    T & operator*() const { return list_->node(index_)->data_; }
+    void increment() { index_ = list_->node(index_)->next_; }
+    ListIterator &operator++() { increment(); return *this; }
+    ListIterator operator++(int unused) { ListIterator retval(*this); increment(); return retval; }
+  private:
+    CompactLinkedList *list_;
+    uint32_t index_;
+  };
+
+public:
+  typedef ListIterator iterator;
+  typedef ListIterator const_iterator;
+
+  /**
+   * The size of one node, the array holds capacity() of them
+   */
+  static const std::size_t NODE_SIZE = sizeof(Slot);
+
+  CompactLinkedList() :
+    nodes_(NULL),
+    capacity_(0),
+    carved_(0),
+    freeList_(NIL),
+    head_(NIL),
+    tail_(NIL),
+    size_(0)
+  {
+  }
+
+  ~CompactLinkedList()
+  {
+    reset();
+  }
+
+  /**
+   * Return an iterator to the beginning of the Linked List.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator begin() { emptyException(); return ListIterator(this, head_); }
+  const_iterator begin() const { emptyException(); return ListIterator(const_cast<CompactLinkedList*>(this), head_); }
+
+  /**
+   * Return an iterator indicating the end of the Linked List has been reached
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator end() { emptyException(); return ListIterator(); }
+  const_iterator end() const { emptyException(); return ListIterator(); }
+
+  /**
+   * Return the number of elements in the linked list
+   */
+  inline uint32_t size() const { return size_; }
+
+  /**
+   * Return true if the list is empty, false otherwise
+   */
+  inline bool empty() const { return size_ == 0; }
+
+  /**
+   * Return the number of nodes the array can hold before growing
+   */
+  inline uint32_t capacity() const { return capacity_; }
+
+  /**
+   * Grow the array to hold at least capacity nodes, so that
+   * inserting up to capacity elements doesn't move the elements
+   */
+  void reserve(uint32_t capacity)
+  {
+    if(capacity > capacity_)
+    {
+      grow(capacity);
+    }
+  }
+
+  /**
+   * Insert a data node into the head of the Linked List.
+   * Algorithmic complexity = O(1) amortized, the array may grow
+   */
+  void insert(const T &data) { emplace_front(data); }
+  void insert(T &&data) { emplace_front(std::move(data)); }
+
+  /**
+   * Append a data node onto the end of the Linked List
+   * Algorithmic complexity = O(1) amortized, the array may grow
+   */
+  void append(const T &data) { emplace_back(data); }
+  void append(T &&data) { emplace_back(std::move(data)); }
+
+  /**
+   * Insert a data node into the head of the Linked List,
+   * constructing the data in place with the given arguments
+   */
+  template <class... Args>
+  void emplace_front(Args&&... args)
+  {
+    uint32_t index(createNode(head_, std::forward<Args>(args)...));
+    head_ = index;
+    if(tail_ == NIL)
+    {
+      tail_ = index;
+    }
+    ++size_;
+  }
+
+  /**
+   * Append a data node onto the end of the Linked List,
+   * constructing the data in place with the given arguments
+   */
+  template <class... Args>
+  void emplace_back(Args&&... args)
+  {
+    uint32_t index(createNode(NIL, std::forward<Args>(args)...));
+    if(tail_ == NIL)
+    {
+      head_ = index;
+    }
+    else
+    {
+      node(tail_)->next_ = index;
+    }
+    tail_ = index;
+    ++size_;
+  }
+
+  /**
+   * Remove the node from the head of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    emptyException();
+
+    uint32_t index(head_);
+    head_ = node(index)->next_;
+    if(head_ == NIL)
+    {
+      tail_ = NIL;
+    }
+    destroyNode(index);
+    --size_;
+  }
+
+  /**
+   * Remove the node from the tail of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   * Algorithmic complexity = O(n), the nodes are walked to find the penultimate one
+   */
+  void pop_back()
+  {
+    emptyException();
+
+    if(head_ == tail_)
+    {
+      destroyNode(tail_);
+      head_ = tail_ = NIL;
+      size_ = 0;
+      return;
+    }
+
+    // Iterate to the penultimate node
+    uint32_t index(head_);
+    while(node(index)->next_ != tail_)
+    {
+      index = node(index)->next_;
+    }
+    destroyNode(tail_);
+    tail_ = index;
+    node(tail_)->next_ = NIL;
+    --size_;
+  }
+
+  /**
+  * Release the LinkedList resources, emptying the list and freeing the array
+  */
+  void reset()
+  {
+    if(!std::is_trivially_destructible<T>::value)
+    {
+      for(uint32_t index = head_; index != NIL; )
+      {
+        uint32_t next(node(index)->next_);
+        node(index)->~ListNode();
+        index = next;
+      }
+    }
+
+    ::operator delete(nodes_);
+    nodes_ = NULL;
+    capacity_ = carved_ = 0;
+    freeList_ = head_ = tail_ = NIL;
+    size_ = 0;
+  }
+
+  /**
+   * Return the first element in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &front() { emptyException(); return node(head_)->data_; }
+  const T &front() const { emptyException(); return node(head_)->data_; }
+
+  /**
+   * Return the last element in the Linked List without modifying the list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &back() { emptyException(); return node(tail_)->data_; }
+  const T &back() const { emptyException(); return node(tail_)->data_; }
+
+private:
+
+  /*
+   * Copying would share the array, and the dtor would free it twice
+   */
+  CompactLinkedList(const CompactLinkedList &);
+  CompactLinkedList &operator=(const CompactLinkedList &);
+
+  ListNode *node(uint32_t index) const { return reinterpret_cast<ListNode*>(nodes_ + index); }
+
+  /**
+   * Internal method to get the free list link stored in a free slot
+   */
+  uint32_t &freeLink(uint32_t index) const { return *reinterpret_cast<uint32_t*>(nodes_ + index); }
+
+  /**
+   * Internal method to construct a node in a free slot, the array grows if there's none.
+   * Return the index of the node.
+   */
+  template <class... Args>
+  uint32_t createNode(uint32_t next, Args&&... args)
+  {
+    if(freeList_ == NIL && carved_ == capacity_)
+    {
+      if(capacity_ == NIL)
+      {
+        LIST_THROW(std::length_error("the list can't hold more nodes"));
+      }
+      uint32_t capacity(capacity_ < 8 ? 8 : (capacity_ > NIL / 2 ? NIL : capacity_ * 2));
+      Slot *nodes(static_cast<Slot*>(::operator new(std::size_t(capacity) * sizeof(Slot))));
+
+      // Like std::vector, the new node is constructed in the new array before the elements
+      // are moved out of the old one, as args may refer to one of them
+      ListNode *created(reinterpret_cast<ListNode*>(nodes + carved_));
+      LIST_TRY
+      {
+        new (created) ListNode(next, std::forward<Args>(args)...);
+        LIST_TRY
+        {
+          moveNodes(nodes);
+        }
+        LIST_CATCH_ALL
+        {
+          created->~ListNode();
+          LIST_RETHROW;
+        }
+      }
+      LIST_CATCH_ALL
+      {
+        ::operator delete(nodes);
+        LIST_RETHROW;
+      }
+      replaceNodes(nodes, capacity);
+      return carved_++;
+    }
+
+    // The slot is only taken once the node is constructed, in case it throws
+    uint32_t index(freeList_ != NIL ? freeList_ : carved_);
+    uint32_t nextFree(freeList_ != NIL ? freeLink(index) : NIL);
+    new (node(index)) ListNode(next, std::forward<Args>(args)...);
+    if(freeList_ != NIL)
+    {
+      freeList_ = nextFree;
+    }
+    else
+    {
+      ++carved_;
+    }
+
+    return index;
+  }
+
+  /**
+   * Internal method to destroy a node and put its slot in the free list
+   */
+  void destroyNode(uint32_t index)
+  {
+    node(index)->~ListNode();
+    new (nodes_ + index) uint32_t(freeList_);
+    freeList_ = index;
+  }
+
+  /**
+   * Internal method to move the nodes into a new array of capacity nodes, at the same indices.
+   * The elements are moved, or copied if their move may throw, in which case the list is unchanged.
+   */
+  void grow(uint32_t capacity)
+  {
+    Slot *nodes(static_cast<Slot*>(::operator new(std::size_t(capacity) * sizeof(Slot))));
+    LIST_TRY
+    {
+      moveNodes(nodes);
+    }
+    LIST_CATCH_ALL
+    {
+      ::operator delete(nodes);
+      LIST_RETHROW;
+    }
+    replaceNodes(nodes, capacity);
+  }
+
+  /**
+   * Internal method to move the nodes into the new array nodes, at the same indices.
+   * If moving an element throws, the nodes already moved are destroyed, and the list is unchanged.
+   */
+  void moveNodes(Slot *nodes)
+  {
+    uint32_t index(head_);
+    LIST_TRY
+    {
+      for(; index != NIL; index = node(index)->next_)
+      {
+        new (nodes + index) ListNode(node(index)->next_, std::move_if_noexcept(node(index)->data_));
+      }
+    }
+    LIST_CATCH_ALL
+    {
+      for(uint32_t moved = head_; moved != index; moved = node(moved)->next_)
+      {
+        reinterpret_cast<ListNode*>(nodes + moved)->~ListNode();
+      }
+      LIST_RETHROW;
+    }
+  }
+
+  /**
+   * Internal method to replace the array by nodes, of capacity nodes, once the nodes are moved into it
+   */
+  void replaceNodes(Slot *nodes, uint32_t capacity)
+  {
+    uint32_t index;
+    for(index = freeList_; index != NIL; index = freeLink(index))
+    {
+      new (nodes + index) uint32_t(freeLink(index));
+    }
+    if(!std::is_trivially_destructible<T>::value)
+    {
+      // Following the links of the new nodes, the old ones are destroyed
+      for(index = head_; index != NIL; index = reinterpret_cast<ListNode*>(nodes + index)->next_)
+      {
+        node(index)->~ListNode();
+      }
+    }
+
+    ::operator delete(nodes_);
+    nodes_ = nodes;
+    capacity_ = capacity;
+  }
+
+  /**
+   * Internal method to check if the Linked List is empty.
+   * Throws a std::length_error exception if it is empty
+   */
+  void emptyException() const
+  {
+    if(empty())
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+  }
+
+  Slot *nodes_;
+  uint32_t capacity_;
+  uint32_t carved_;    // number of slots used at least once, the following ones were never used
+  uint32_t freeList_;
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t size_;
+};
+
+#endif /* COMPACTLINKEDLIST_HH_ */
@@ -0,0 +1,379 @@
+/*
+ * ConcurrentLinkedList.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef CONCURRENTLINKEDLIST_HH_
+#define CONCURRENTLINKEDLIST_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <stdint.h>
+
+#include "ListPolicies.hh"
+
+/**
+ * A lock-free multi-producer/multi-consumer single LinkedList, used as a
+ * FIFO work queue: any number of threads may append() and pop_front()
+ * concurrently, without an external mutex.
+ *
+ * It is a Michael-Scott queue: head_ always points to a dummy node, and
+ * the front element is stored in the node following it. Removed nodes are
+ * reclaimed with hazard pointers, so a node is never freed while another
+ * thread may still be reading it. MaxThreads is the maximum number of
+ * threads that can be operating on the list at the same time, additional
+ * threads wait for a hazard record to become available.
+ *
+ * Elements are copied out of the list, and destroyed when their node is
+ * reclaimed, so front() may safely read an element a consumer is removing.
+ */
+template <class T, uint32_t MaxThreads = 64>
+class ConcurrentLinkedList
+{
+private:
+  /**
+   * Internal class used to store the data in the Linked List
+   */
+  struct ListNode
+  {
+    ListNode() : next_(NULL), hasData_(false) {}
+    ListNode(const T &data) : next_(NULL), hasData_(true) { new (&data_) T(data); }
+    ~ListNode() { if(hasData_) { this->data()->~T(); } }
+    T *data() { return reinterpret_cast<T*>(&data_); }
+    std::atomic<ListNode*> next_;
+    bool hasData_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type data_;
+  };
+
+  static const uint32_t CACHE_LINE = 64;
+
+  /**
+   * Internal class holding the hazard pointers of the thread currently
+   * using it, and the nodes it removed that could not yet be reclaimed.
+   * Padded so records used by different threads don't share cache lines.
+   */
+  struct HazardRecord
+  {
+    HazardRecord() : active_(false) { hazard_[0] = hazard_[1] = NULL; }
+    std::atomic<bool> active_;
+    std::atomic<ListNode*> hazard_[2];
+    std::vector<ListNode*> retired_;
+    char padding_[CACHE_LINE];
+  };
+
+  /**
+   * Internal RAII class to acquire a HazardRecord for the duration of one operation
+   */
+  class RecordGuard
+  {
+  public:
+    RecordGuard(ConcurrentLinkedList &list) : record_(list.acquireRecord()) {}
+    ~RecordGuard()
+    {
+      clear();
+      record_.active_.store(false, std::memory_order_release);
+    }
+
+    void clear()
+    {
+      record_.hazard_[0].store(NULL, std::memory_order_release);
+      record_.hazard_[1].store(NULL, std::memory_order_release);
+    }
+
+    /**
+     * Publish a hazard pointer on the node src points to, and return it.
+     * The node can't be reclaimed until the hazard pointer is cleared.
+     */
+    ListNode *protect(int index, const std::atomic<ListNode*> &src)
+    {
+      ListNode *node(src.load(std::memory_order_acquire));
+      for(;;)
+      {
+        record_.hazard_[index].store(node, std::memory_order_seq_cst);
+        ListNode *current(src.load(std::memory_order_seq_cst));
+        if(current == node)
+        {
+          return node;
+        }
+        node = current;
+      }
+    }
+
+    HazardRecord &record() { return record_; }
+
+  private:
+    HazardRecord &record_;
+  };
+
+public:
+  ConcurrentLinkedList() :
+    head_(new ListNode()),
+    tail_(head_.load()),
+    size_(0)
+  {
+  }
+
+  /**
+   * Not thread safe: no other thread may be using the list
+   */
+  ~ConcurrentLinkedList()
+  {
+    ListNode *node(head_.load());
+    while(node != NULL)
+    {
+      ListNode *next(node->next_.load());
+      delete node;
+      node = next;
+    }
+
+    for(uint32_t i = 0; i < MaxThreads; ++i)
+    {
+      std::vector<ListNode*> &retired(records_[i].retired_);
+      for(size_t j = 0; j < retired.size(); ++j)
+      {
+        delete retired[j];
+      }
+    }
+  }
+
+  /**
+   * Return the number of elements in the linked list.
+   * Only approximate when other threads are modifying the list: it may
+   * count elements still being appended, but never wraps below 0.
+   */
+  inline uint32_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  /**
+   * Return true if the list is empty, false otherwise.
+   * Only a snapshot when other threads are modifying the list.
+   */
+  bool empty()
+  {
+    RecordGuard guard(*this);
+    ListNode *head(guard.protect(0, head_));
+    return head->next_.load(std::memory_order_acquire) == NULL;
+  }
+
+  /**
+   * Append a data node onto the end of the Linked List
+   */
+  void append(const T &data)
+  {
+    ListNode *newNode(new ListNode(data));
+    RecordGuard guard(*this);
+
+    // Counted before it's linked, so that it can't be popped and uncounted first
+    size_.fetch_add(1, std::memory_order_relaxed);
+
+    for(;;)
+    {
+      ListNode *tail(guard.protect(0, tail_));
+      ListNode *next(tail->next_.load(std::memory_order_acquire));
+      if(tail != tail_.load(std::memory_order_acquire))
+      {
+        continue;
+      }
+
+      if(next != NULL)
+      {
+        // The tail is lagging behind, help move it forward
+        tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+        continue;
+      }
+
+      if(tail->next_.compare_exchange_weak(next, newNode, std::memory_order_release, std::memory_order_relaxed))
+      {
+        tail_.compare_exchange_strong(tail, newNode, std::memory_order_release, std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+
+  /**
+   * Copy the first element into data and remove it from the Linked List.
+   * Return false if the list is empty.
+   */
+  bool try_pop_front(T &data)
+  {
+    return popFront(&data);
+  }
+
+  /**
+   * Remove the node from the head of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    if(!popFront(NULL))
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+  }
+
+  /**
+   * Return a copy of the first element in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T front()
+  {
+    RecordGuard guard(*this);
+
+    for(;;)
+    {
+      ListNode *head(guard.protect(0, head_));
+      ListNode *next(guard.protect(1, head->next_));
+      if(head != head_.load(std::memory_order_acquire))
+      {
+        continue;
+      }
+
+      if(next == NULL)
+      {
+        LIST_THROW(std::length_error("the list is empty"));
+      }
+
+      return *next->data();
+    }
+  }
+
+private:
+
+  /*
+   * The list can't be copied
+   */
+  ConcurrentLinkedList(const ConcurrentLinkedList &);
+  ConcurrentLinkedList &operator=(const ConcurrentLinkedList &);
+
+  /**
+   * Internal method to remove the first element, copying it into data unless data is NULL.
+   * Return false if the list is empty.
+   */
+  bool popFront(T *data)
+  {
+    RecordGuard guard(*this);
+
+    for(;;)
+    {
+      ListNode *head(guard.protect(0, head_));
+      ListNode *tail(tail_.load(std::memory_order_acquire));
+      ListNode *next(guard.protect(1, head->next_));
+      if(head != head_.load(std::memory_order_acquire))
+      {
+        continue;
+      }
+
+      if(next == NULL)
+      {
+        return false;
+      }
+
+      if(head == tail)
+      {
+        // The tail is lagging behind, help move it forward
+        tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+        continue;
+      }
+
+      // Copy the element before unlinking: once unlinked, its node may be reclaimed
+      if(data != NULL)
+      {
+        *data = *next->data();
+      }
+
+      if(head_.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+      {
+        // next is the new dummy node, its element is destroyed when it's reclaimed
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        guard.clear();
+        retire(guard.record(), head);
+        return true;
+      }
+    }
+  }
+
+  /**
+   * Internal method to get exclusive use of a HazardRecord.
+   * Each thread starts looking at a different record to avoid contention.
+   */
+  HazardRecord &acquireRecord()
+  {
+    static thread_local uint32_t hint(std::hash<std::thread::id>()(std::this_thread::get_id()) % MaxThreads);
+
+    for(;;)
+    {
+      for(uint32_t i = 0; i < MaxThreads; ++i)
+      {
+        HazardRecord &record(records_[(hint + i) % MaxThreads]);
+        if(!record.active_.load(std::memory_order_relaxed) &&
+           !record.active_.exchange(true, std::memory_order_acquire))
+        {
+          return record;
+        }
+      }
+
+      // More than MaxThreads threads are using the list
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * Internal method to reclaim a node removed from the list once no hazard pointer protects it.
+   * The retired nodes are only scanned once there are enough of them to amortize the scan.
+   */
+  void retire(HazardRecord &record, ListNode *node)
+  {
+    record.retired_.push_back(node);
+    if(record.retired_.size() < 2 * MaxThreads)
+    {
+      return;
+    }
+
+    std::vector<ListNode*> hazards;
+    hazards.reserve(2 * MaxThreads);
+    for(uint32_t i = 0; i < MaxThreads; ++i)
+    {
+      for(int j = 0; j < 2; ++j)
+      {
+        ListNode *hazard(records_[i].hazard_[j].load(std::memory_order_seq_cst));
+        if(hazard != NULL)
+        {
+          hazards.push_back(hazard);
+        }
+      }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    std::vector<ListNode*> stillHazardous;
+    for(size_t i = 0; i < record.retired_.size(); ++i)
+    {
+      if(std::binary_search(hazards.begin(), hazards.end(), record.retired_[i]))
+      {
+        stillHazardous.push_back(record.retired_[i]);
+      }
+      else
+      {
+        delete record.retired_[i];
+      }
+    }
+    record.retired_.swap(stillHazardous);
+  }
+
+  // The producers and consumers fields are on separate cache lines
+  char padding0_[CACHE_LINE];
+  std::atomic<ListNode*> head_;
+  char padding1_[CACHE_LINE];
+  std::atomic<ListNode*> tail_;
+  char padding2_[CACHE_LINE];
+  std::atomic<uint32_t> size_;
+  char padding3_[CACHE_LINE];
+  HazardRecord records_[MaxThreads];
+};
+
+#endif /* CONCURRENTLINKEDLIST_HH_ */
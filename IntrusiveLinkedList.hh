@@ -0,0 +1,356 @@
+/*
+ * IntrusiveLinkedList.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INTRUSIVELINKEDLIST_HH_
+#define INTRUSIVELINKEDLIST_HH_
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <stdint.h>
+
+#include "ListPolicies.hh"
+
+/**
+ * The hook an object embeds to be linked in an IntrusiveLinkedList, either
+ * as a base class or as a member. An object can be in as many lists at the
+ * same time as it has hooks, but each hook can only be in one list.
+ * The hooks are doubly linked, so any object can be unlinked in O(1), and
+ * remember their list, so membership can be checked in O(1).
+ */
+class IntrusiveListHook
+{
+public:
+  IntrusiveListHook() : next_(NULL), prev_(NULL), owner_(NULL) {}
+
+  /*
+   * Copying an object doesn't copy its list memberships
+   */
+  IntrusiveListHook(const IntrusiveListHook &) : next_(NULL), prev_(NULL), owner_(NULL) {}
+  IntrusiveListHook &operator=(const IntrusiveListHook &) { return *this; }
+
+  /**
+   * Return true if the hook is linked in a list
+   */
+  bool is_linked() const { return owner_ != NULL; }
+
+private:
+  template <class T, class HookPolicy> friend class IntrusiveLinkedList;
+
+  IntrusiveListHook *next_;
+  IntrusiveListHook *prev_;
+  const void *owner_;
+};
+
+/**
+ * The hook policy for objects deriving from IntrusiveListHook
+ */
+template <class T>
+struct BaseHook
+{
+  static IntrusiveListHook *toHook(T *object) { return object; }
+  static T *toObject(IntrusiveListHook *hook) { return static_cast<T*>(hook); }
+};
+
+/**
+ * The hook policy for objects with an IntrusiveListHook member,
+ * for example: IntrusiveLinkedList<Object, MemberHook<Object, &Object::hook_> >
+ */
+template <class T, IntrusiveListHook T::*Member>
+struct MemberHook
+{
+  static IntrusiveListHook *toHook(T *object) { return &(object->*Member); }
+  static T *toObject(IntrusiveListHook *hook)
+  {
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - offset());
+  }
+
+private:
+  /**
+   * Internal method to get the offset of the hook in the object, from real storage for a T,
+   * so that no made up address is dereferenced. No T is constructed in it.
+   */
+  static std::ptrdiff_t offset()
+  {
+    static typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    T *object(reinterpret_cast<T*>(&storage));
+    return reinterpret_cast<char*>(&(object->*Member)) - reinterpret_cast<char*>(object);
+  }
+};
+
+/**
+ * An intrusive LinkedList: the list links the hooks embedded in existing
+ * objects, instead of allocating nodes and copying the objects into them.
+ * Inserting, appending and removing never allocate, and an object can be
+ * unlinked in O(1) wherever it is in the list.
+ * The list doesn't own the objects: they must outlive their membership,
+ * and are only unlinked, not destroyed, when removed or when the list is
+ * destroyed. The HookPolicy is BaseHook<T> or MemberHook<T, &T::hook>.
+ */
+template <class T, class HookPolicy = BaseHook<T> >
+class IntrusiveLinkedList
+{
+private:
+  /**
+   * Internal class used to iterate the Linked List
+   */
+  class ListIterator
+  {
+  public:
+    ListIterator() : hook_(NULL) {}
+    ListIterator(IntrusiveListHook *hook) : hook_(hook) {}
+    bool operator==(ListIterator rhs) const { return rhs.hook_ == hook_; }
+    bool operator!=(ListIterator rhs) const { return rhs.hook_ != hook_; }
+    T * operator->() const { return HookPolicy::toObject(hook_); }
+    T & operator*() const { return *HookPolicy::toObject(hook_); }
+    void increment() { hook_ = hook_->next_; }
+    ListIterator &operator++() { increment(); return *this; }
+    ListIterator operator++(int unused) { ListIterator retval(*this); increment(); return retval; }
+  private:
+    IntrusiveListHook *hook_;
+  };
+
+public:
+  typedef ListIterator iterator;
+  typedef ListIterator const_iterator;
+
+  IntrusiveLinkedList() :
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+  }
+
+  /**
+   * Unlink all the objects, they are not destroyed
+   */
+  ~IntrusiveLinkedList()
+  {
+    reset();
+  }
+
+  /**
+   * Return an iterator to the beginning of the Linked List.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator begin() const { emptyException(); return ListIterator(head_); }
+
+  /**
+   * Return an iterator indicating the end of the Linked List has been reached
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator end() const { emptyException(); return ListIterator(); }
+
+  /**
+   * Return the number of objects in the linked list
+   */
+  inline uint32_t size() const { return size_; }
+
+  /**
+   * Return true if the list is empty, false otherwise
+   */
+  inline bool empty() const { return size_ == 0; }
+
+  /**
+   * Return true if object is linked in this list. Algorithmic complexity = O(1)
+   */
+  bool contains(const T &object) const
+  {
+    return HookPolicy::toHook(const_cast<T*>(&object))->owner_ == this;
+  }
+
+  /**
+   * Link object into the head of the Linked List, without allocating nor copying it.
+   * If its hook is already linked, an std::invalid_argument exception will be thrown.
+   */
+  void insert(T &object)
+  {
+    IntrusiveListHook *hook(linkableHook(object));
+    hook->prev_ = NULL;
+    hook->next_ = head_;
+    if(head_ == NULL)
+    {
+      tail_ = hook;
+    }
+    else
+    {
+      head_->prev_ = hook;
+    }
+    head_ = hook;
+    ++size_;
+  }
+
+  /**
+   * Link object onto the end of the Linked List, without allocating nor copying it.
+   * If its hook is already linked, an std::invalid_argument exception will be thrown.
+   */
+  void append(T &object)
+  {
+    IntrusiveListHook *hook(linkableHook(object));
+    hook->next_ = NULL;
+    hook->prev_ = tail_;
+    if(tail_ == NULL)
+    {
+      head_ = hook;
+    }
+    else
+    {
+      tail_->next_ = hook;
+    }
+    tail_ = hook;
+    ++size_;
+  }
+
+  /**
+   * Unlink the object at the head of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    emptyException();
+    unlink(head_);
+  }
+
+  /**
+   * Unlink the object at the tail of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   * Algorithmic complexity = O(1)
+   */
+  void pop_back()
+  {
+    emptyException();
+    unlink(tail_);
+  }
+
+  /**
+   * Unlink object from the Linked List, wherever it is. Algorithmic complexity = O(1)
+   * If object is not in this list, an std::invalid_argument exception will be thrown.
+   */
+  void remove(T &object)
+  {
+    if(!contains(object))
+    {
+      LIST_THROW(std::invalid_argument("the object is not in this list"));
+    }
+    unlink(HookPolicy::toHook(&object));
+  }
+
+  /**
+   * Return the first object in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &front() const { emptyException(); return *HookPolicy::toObject(head_); }
+
+  /**
+   * Return the last object in the Linked List without modifying the list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &back() const { emptyException(); return *HookPolicy::toObject(tail_); }
+
+  /**
+   * Unlink all the objects, emptying the list. The objects are not destroyed.
+   */
+  void reset()
+  {
+    IntrusiveListHook *hook(head_);
+    while(hook != NULL)
+    {
+      IntrusiveListHook *next(hook->next_);
+      hook->next_ = hook->prev_ = NULL;
+      hook->owner_ = NULL;
+      hook = next;
+    }
+    head_ = tail_ = NULL;
+    size_ = 0;
+  }
+
+  /**
+   * Reverse the order of all the objects in the Linked List
+   * Algorithmic complexity = O(n), No extra memory is used
+   */
+  void reverse()
+  {
+    IntrusiveListHook *hook(head_);
+    while(hook != NULL)
+    {
+      IntrusiveListHook *next(hook->next_);
+      hook->next_ = hook->prev_;
+      hook->prev_ = next;
+      hook = next;
+    }
+    IntrusiveListHook *oldHead(head_);
+    head_ = tail_;
+    tail_ = oldHead;
+  }
+
+private:
+
+  /*
+   * The list can't be copied, the objects can only be in one list per hook
+   */
+  IntrusiveLinkedList(const IntrusiveLinkedList &);
+  IntrusiveLinkedList &operator=(const IntrusiveLinkedList &);
+
+  /**
+   * Internal method to get the hook of object and mark it as linked in this list
+   */
+  IntrusiveListHook *linkableHook(T &object)
+  {
+    IntrusiveListHook *hook(HookPolicy::toHook(&object));
+    if(hook->is_linked())
+    {
+      LIST_THROW(std::invalid_argument("the object is already linked in a list"));
+    }
+    hook->owner_ = this;
+    return hook;
+  }
+
+  /**
+   * Internal method to unlink a hook of this list
+   */
+  void unlink(IntrusiveListHook *hook)
+  {
+    if(hook->prev_ == NULL)
+    {
+      head_ = hook->next_;
+    }
+    else
+    {
+      hook->prev_->next_ = hook->next_;
+    }
+
+    if(hook->next_ == NULL)
+    {
+      tail_ = hook->prev_;
+    }
+    else
+    {
+      hook->next_->prev_ = hook->prev_;
+    }
+
+    hook->next_ = hook->prev_ = NULL;
+    hook->owner_ = NULL;
+    --size_;
+  }
+
+  /**
+   * Internal method to check if the Linked List is empty.
+   * Throws a std::length_error exception if it is empty
+   */
+  void emptyException() const
+  {
+    if(empty())
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+  }
+
+  IntrusiveListHook *head_;
+  IntrusiveListHook *tail_;
+  uint32_t size_;
+};
+
+#endif /* INTRUSIVELINKEDLIST_HH_ */
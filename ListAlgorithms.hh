@@ -0,0 +1,376 @@
+/*
+ * ListAlgorithms.hh
+ *
+ * Traversal algorithms hiding the memory latency of the list links,
+ * and parallel algorithms running on the list segments
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef LISTALGORITHMS_HH_
+#define LISTALGORITHMS_HH_
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include <stdint.h>
+
+#include "ThreadPool.hh"
+
+/*
+ * Following the links of a large list is bound by the memory latency: the
+ * address of each node is only known once the previous node is loaded.
+ * These algorithms work on the iterators of any of the lists, and prefetch
+ * the nodes through the address of their data.
+ */
+#if defined(__GNUC__)
+#define LIST_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define LIST_PREFETCH(address)
+#endif
+
+/**
+ * The number of nodes the prefetching algorithms look ahead by default
+ */
+static const uint32_t LIST_PREFETCH_DISTANCE = 8;
+
+/**
+ * The number of tasks the parallel algorithms split the list into. It doesn't
+ * depend on the number of threads, so neither do the parallel_reduce() results.
+ */
+static const uint32_t LIST_PARALLEL_TASKS = 64;
+
+/**
+ * Call f on every element of [first, last), prefetching the nodes distance
+ * nodes ahead. The lookahead still follows the links one by one, so this
+ * only helps when f does enough work per element to hide the loads, use
+ * a JumpIndex to have several nodes loading at once.
+ * Return f, like std::for_each()
+ */
+template <class Iterator, class Function>
+Function prefetch_for_each(Iterator first, Iterator last, Function f, uint32_t distance = LIST_PREFETCH_DISTANCE)
+{
+  Iterator ahead(first);
+  for(uint32_t i = 0; i < distance && ahead != last; ++i)
+  {
+    LIST_PREFETCH(&(*ahead));
+    ahead.increment();
+  }
+
+  for(; first != last; first.increment())
+  {
+    if(ahead != last)
+    {
+      LIST_PREFETCH(&(*ahead));
+      ahead.increment();
+    }
+    f(*first);
+  }
+
+  return f;
+}
+
+/**
+ * Skip links for the prefetcher, kept beside the list so its nodes don't
+ * grow: an iterator to every stride-th node of a range. The segments
+ * between the skip links can be followed independently, so the loads of
+ * several segments overlap instead of waiting on each other.
+ * Like any saved iterator, the index is invalidated by removing the nodes
+ * it points to, and doesn't see the nodes inserted or reordered after it
+ * was built: rebuild it after modifying the list.
+ */
+template <class Iterator>
+class JumpIndex
+{
+public:
+  /**
+   * Index the range [first, last), stride must be at least 1
+   * Algorithmic complexity = O(n), one pointer per stride nodes is used
+   */
+  JumpIndex(Iterator first, Iterator last, uint32_t stride = 64) :
+    last_(last),
+    stride_(stride),
+    size_(0)
+  {
+    for(uint32_t i = 0; first != last; first.increment(), ++i)
+    {
+      if(i == stride_)
+      {
+        i = 0;
+      }
+      if(i == 0)
+      {
+        jumps_.push_back(first);
+      }
+      ++size_;
+    }
+  }
+
+  /**
+   * Return the number of segments, each stride nodes long, but the last one
+   */
+  std::size_t segments() const { return jumps_.size(); }
+
+  /**
+   * Return an iterator to the first node of segment
+   */
+  Iterator segmentBegin(std::size_t segment) const { return jumps_[segment]; }
+
+  /**
+   * Return an iterator past the last node of segment
+   */
+  Iterator segmentEnd(std::size_t segment) const
+  {
+    return segment + 1 < jumps_.size() ? jumps_[segment + 1] : last_;
+  }
+
+  /**
+   * Return the number of nodes indexed
+   */
+  uint32_t size() const { return size_; }
+
+  uint32_t stride() const { return stride_; }
+
+private:
+  std::vector<Iterator> jumps_;
+  Iterator last_;
+  uint32_t stride_;
+  uint32_t size_;
+};
+
+/**
+ * Call f in order on every element indexed by index. While a segment is
+ * visited, the next lookahead segments are followed and prefetched in
+ * turns, one node per element, so that their loads don't wait on each
+ * other and each segment is loaded by the time it's visited.
+ * Return f, like std::for_each()
+ */
+template <class Iterator, class Function>
+Function prefetch_for_each(const JumpIndex<Iterator> &index, Function f, uint32_t lookahead = LIST_PREFETCH_DISTANCE)
+{
+  std::size_t segments(index.segments());
+  std::vector<Iterator> ahead;
+  for(std::size_t segment = 1; segment <= lookahead && segment < segments; ++segment)
+  {
+    ahead.push_back(index.segmentBegin(segment));
+  }
+
+  std::size_t turn(0);
+  for(std::size_t segment = 0; segment < segments; ++segment)
+  {
+    // Move the lookahead window one segment on, ahead[i] is in segment + 1 + i
+    if(segment > 0 && !ahead.empty())
+    {
+      ahead.erase(ahead.begin());
+      if(segment + lookahead < segments)
+      {
+        ahead.push_back(index.segmentBegin(segment + lookahead));
+      }
+    }
+
+    std::size_t numAhead(ahead.size());
+    Iterator end(index.segmentEnd(segment));
+    for(Iterator iter(index.segmentBegin(segment)); iter != end; iter.increment())
+    {
+      if(numAhead > 0)
+      {
+        turn = (turn + 1 < numAhead ? turn + 1 : 0);
+        if(ahead[turn] != index.segmentEnd(segment + 1 + turn))
+        {
+          LIST_PREFETCH(&(*ahead[turn]));
+          ahead[turn].increment();
+        }
+      }
+      f(*iter);
+    }
+  }
+
+  return f;
+}
+
+/**
+ * Return the reduction of init and all the elements indexed by index with
+ * op, which must be associative, and the elements must convert to T:
+ * width segments are followed at the same time, each reduced on its own,
+ * so that width node loads are in flight. The partial results are then
+ * reduced in order.
+ */
+template <class Iterator, class T, class BinaryOperation>
+T prefetch_reduce(const JumpIndex<Iterator> &index, T init, BinaryOperation op, uint32_t width = LIST_PREFETCH_DISTANCE)
+{
+  if(width == 0)
+  {
+    width = 1;
+  }
+
+  std::size_t segments(index.segments());
+  std::vector<Iterator> iters;
+  std::vector<Iterator> ends;
+  std::vector<T> partials;
+  for(std::size_t first = 0; first < segments; first += width)
+  {
+    iters.clear();
+    ends.clear();
+    partials.clear();
+    for(std::size_t segment = first; segment < first + width && segment < segments; ++segment)
+    {
+      iters.push_back(index.segmentBegin(segment));
+      ends.push_back(index.segmentEnd(segment));
+      partials.push_back(*iters.back());
+      iters.back().increment();
+    }
+
+    // All the segments but the last have stride nodes, so they're done together
+    bool done(false);
+    while(!done)
+    {
+      done = true;
+      for(std::size_t i = 0; i < iters.size(); ++i)
+      {
+        if(iters[i] != ends[i])
+        {
+          partials[i] = op(partials[i], *iters[i]);
+          iters[i].increment();
+          done = false;
+        }
+      }
+    }
+
+    for(std::size_t i = 0; i < partials.size(); ++i)
+    {
+      init = op(init, partials[i]);
+    }
+  }
+
+  return init;
+}
+
+/**
+ * Return a JumpIndex splitting list into about segments segments of the
+ * same size, found in one pass over the list, to be used by the parallel
+ * algorithms. Keep it to run several algorithms on the same split points.
+ */
+template <class ListType>
+JumpIndex<typename ListType::iterator> split_points(ListType &list, uint32_t segments = LIST_PARALLEL_TASKS)
+{
+  typedef typename ListType::iterator Iterator;
+  if(list.empty())
+  {
+    return JumpIndex<Iterator>(Iterator(), Iterator());
+  }
+
+  uint32_t stride(segments == 0 ? list.size() : (list.size() + segments - 1) / segments);
+  return JumpIndex<Iterator>(list.begin(), list.end(), stride);
+}
+
+/**
+ * Internal function splitting the nodes of index into at most LIST_PARALLEL_TASKS ranges
+ * of whole segments, and running task(i, first, last) for each range [first, last) on
+ * the pool threads, where i is the task number. Return the number of tasks.
+ */
+template <class Iterator, class Task>
+std::size_t runSegments(const JumpIndex<Iterator> &index, Task task, ThreadPool &pool)
+{
+  std::size_t segments(index.segments());
+  std::size_t numTasks(segments < LIST_PARALLEL_TASKS ? segments : LIST_PARALLEL_TASKS);
+  pool.run(numTasks, [&](size_t i) {
+    std::size_t first(i * segments / numTasks);
+    std::size_t last((i + 1) * segments / numTasks);
+    task(i, index.segmentBegin(first), index.segmentEnd(last - 1));
+  });
+
+  return numTasks;
+}
+
+/**
+ * Call f on every element indexed by index, on the pool threads.
+ * The elements are visited concurrently, in no particular order.
+ */
+template <class Iterator, class Function>
+void parallel_for_each(const JumpIndex<Iterator> &index, Function f, ThreadPool &pool = ThreadPool::instance())
+{
+  runSegments(index, [&f](size_t, Iterator first, Iterator last) {
+    for(; first != last; first.increment())
+    {
+      f(*first);
+    }
+  }, pool);
+}
+
+/**
+ * Replace every element indexed by index with op(element), on the pool threads
+ */
+template <class Iterator, class UnaryOperation>
+void parallel_transform(const JumpIndex<Iterator> &index, UnaryOperation op, ThreadPool &pool = ThreadPool::instance())
+{
+  runSegments(index, [&op](size_t, Iterator first, Iterator last) {
+    for(; first != last; first.increment())
+    {
+      *first = op(*first);
+    }
+  }, pool);
+}
+
+/**
+ * Return the reduction of init and all the elements indexed by index with op,
+ * which must be associative, and the elements must convert to T. Each task
+ * reduces its range in order, then the task results are reduced in order,
+ * so the result only depends on the index, not on the number of threads.
+ */
+template <class Iterator, class T, class BinaryOperation>
+T parallel_reduce(const JumpIndex<Iterator> &index, T init, BinaryOperation op, ThreadPool &pool = ThreadPool::instance())
+{
+  std::vector<T> partials;
+  partials.reserve(LIST_PARALLEL_TASKS);
+  for(std::size_t i = 0; i < LIST_PARALLEL_TASKS && i < index.segments(); ++i)
+  {
+    partials.push_back(init);
+  }
+
+  std::size_t numTasks(runSegments(index, [&op, &partials](size_t i, Iterator first, Iterator last) {
+    T partial(*first);
+    for(first.increment(); first != last; first.increment())
+    {
+      partial = op(partial, *first);
+    }
+    partials[i] = partial;
+  }, pool));
+
+  for(std::size_t i = 0; i < numTasks; ++i)
+  {
+    init = op(init, partials[i]);
+  }
+
+  return init;
+}
+
+/**
+ * Return the number of elements indexed by index for which pred returns true,
+ * pred is called on the pool threads
+ */
+template <class Iterator, class Predicate>
+uint32_t parallel_count_if(const JumpIndex<Iterator> &index, Predicate pred, ThreadPool &pool = ThreadPool::instance())
+{
+  std::vector<uint32_t> counts(LIST_PARALLEL_TASKS, 0);
+  runSegments(index, [&pred, &counts](size_t i, Iterator first, Iterator last) {
+    uint32_t count(0);
+    for(; first != last; first.increment())
+    {
+      if(pred(*first))
+      {
+        ++count;
+      }
+    }
+    counts[i] = count;
+  }, pool);
+
+  uint32_t total(0);
+  for(std::size_t i = 0; i < counts.size(); ++i)
+  {
+    total += counts[i];
+  }
+
+  return total;
+}
+
+#endif /* LISTALGORITHMS_HH_ */
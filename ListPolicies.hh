@@ -0,0 +1,131 @@
+/*
+ * ListPolicies.hh
+ *
+ * Compile-time policies used to configure the SimpleLinkedList
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef LISTPOLICIES_HH_
+#define LISTPOLICIES_HH_
+
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+
+/*
+ * The lists can be built without exceptions, with -fno-exceptions: the
+ * try blocks are then always run, the catch blocks never, and throwing aborts.
+ */
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define LIST_TRY try
+#define LIST_CATCH_ALL catch(...)
+#define LIST_RETHROW throw
+#define LIST_THROW(exception) throw exception
+#else
+#define LIST_TRY if(true)
+#define LIST_CATCH_ALL if(false)
+#define LIST_RETHROW
+#define LIST_THROW(exception) std::abort()
+#endif
+
+/*
+ * A link policy defines the links stored in each list node, other than
+ * the next_ link all the nodes have. It has to provide the following:
+ *
+ *   template <class Node> struct Links;  // base class of the list nodes
+ *   static const bool doubly;
+ *   template <class Node> static Node *previous(Node *head, Node *node);
+ *
+ * Links<Node> has to provide setPrev(Node *prev), and previous() returns
+ * the node preceding node, which must not be the head.
+ */
+
+/**
+ * The default link policy: nodes only link to the next node.
+ * No memory is used for the links, but finding the previous node is O(n).
+ */
+struct SinglyLinked
+{
+  template <class Node>
+  struct Links
+  {
+    void setPrev(Node *) {}
+  };
+
+  static const bool doubly = false;
+
+  template <class Node>
+  static Node *previous(Node *head, Node *node)
+  {
+    while(head->next_ != node)
+    {
+      head = head->next_;
+    }
+    return head;
+  }
+};
+
+/**
+ * Nodes also link to the previous node. One more pointer per node,
+ * but finding the previous node, and so pop_back(), is O(1),
+ * and the list can be iterated in reverse.
+ */
+struct DoublyLinked
+{
+  template <class Node>
+  struct Links
+  {
+    Links() : prev_(NULL) {}
+    void setPrev(Node *prev) { prev_ = prev; }
+    Node *prev_;
+  };
+
+  static const bool doubly = true;
+
+  template <class Node>
+  static Node *previous(Node *, Node *node)
+  {
+    return node->prev_;
+  }
+};
+
+/*
+ * An error policy defines what the list does when an element is needed
+ * from an empty list. It has to provide the following:
+ *
+ *   static const bool checked;
+ *   static void emptyError();
+ *
+ * If checked is false, the list doesn't check it's empty, and emptyError() isn't called.
+ */
+
+/**
+ * The default error policy: begin(), end(), front(), back(), pop_front(),
+ * pop_back() and the reversals throw an std::length_error on an empty list.
+ */
+struct ThrowOnEmpty
+{
+  static const bool checked = true;
+
+  static void emptyError()
+  {
+    LIST_THROW(std::length_error("the list is empty"));
+  }
+};
+
+/**
+ * For the hot paths and builds without exceptions: nothing is checked,
+ * like with the std containers. begin() == end() on an empty list and the
+ * reversals do nothing, but front(), back(), pop_front() and pop_back()
+ * must not be called on an empty list: check empty() first, or use the
+ * try_pop_front(), try_pop_back(), front_ptr() and back_ptr() methods.
+ */
+struct NoThrowOnEmpty
+{
+  static const bool checked = false;
+
+  static void emptyError() {}
+};
+
+#endif /* LISTPOLICIES_HH_ */
@@ -0,0 +1,241 @@
+/*
+ * ListStats.hh
+ *
+ * Instrumentation policies used to collect statistics on the SimpleLinkedList
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef LISTSTATS_HH_
+#define LISTSTATS_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <stdint.h>
+
+/*
+ * A stats policy is notified of every list operation. It has to provide the following:
+ *
+ *   typedef ... Timing;
+ *   Timing startOp();
+ *   void endOp(ListOp op, Timing start, uint32_t size, std::size_t nodeBytes);
+ *   void nodesAllocated(uint32_t count);
+ *   void nodesFreed(uint32_t count);
+ *   void popBackWalked(uint32_t steps);
+ *   void emptyThrown() const;
+ *
+ * endOp() is given the list size and the size of one node once the operation
+ * is done. Operations implemented with other operations, like pop_back() on a
+ * single element, nest their startOp() and endOp() calls: only the outer one
+ * should be counted. The list inherits the policy, so an empty policy takes no memory.
+ */
+
+/**
+ * The list operations reported to the stats policy
+ */
+enum ListOp
+{
+  LIST_OP_INSERT,
+  LIST_OP_APPEND,
+  LIST_OP_INSERT_AFTER,
+  LIST_OP_ERASE,
+  LIST_OP_POP_FRONT,
+  LIST_OP_POP_BACK,
+  LIST_OP_RANGE,
+  LIST_OP_SPLICE,
+  LIST_OP_SPLIT,
+  LIST_OP_REVERSE,
+  LIST_OP_SORT,
+  LIST_OP_RESET,
+  LIST_OP_COMPACT,
+  LIST_OP_COUNT
+};
+
+inline const char *listOpName(ListOp op)
+{
+  static const char *names[LIST_OP_COUNT] =
+    {"insert", "append", "insert_after", "erase", "pop_front", "pop_back", "range", "splice", "split", "reverse", "sort", "reset", "compact"};
+  return names[op];
+}
+
+/**
+ * The default stats policy: nothing is collected, every hook is an empty
+ * inline method, so the instrumentation compiles to nothing.
+ */
+struct NoStats
+{
+  struct Timing {};
+
+  Timing startOp() { return Timing(); }
+  void endOp(ListOp, Timing, uint32_t, std::size_t) {}
+  void nodesAllocated(uint32_t) {}
+  void nodesFreed(uint32_t) {}
+  void popBackWalked(uint32_t) {}
+  void emptyThrown() const {}
+};
+
+/**
+ * A copy of the statistics collected by the CountingStats policy
+ */
+struct ListStatsSnapshot
+{
+  /**
+   * The latencies are counted in buckets of powers of 2 nanoseconds:
+   * bucket 0 is [0, 2) ns, and bucket i is [2^i, 2^(i+1)) ns.
+   * The last bucket also counts all the longer latencies.
+   */
+  static const uint32_t LATENCY_BUCKETS = 32;
+
+  ListStatsSnapshot() :
+    size_(0), peakSize_(0), bytesInUse_(0), peakBytesInUse_(0),
+    nodesAllocated_(0), nodesFreed_(0),
+    popBackWalks_(0), popBackWalkSteps_(0), maxPopBackWalk_(0),
+    emptyThrows_(0)
+  {
+    for(uint32_t op = 0; op < LIST_OP_COUNT; ++op)
+    {
+      opCounts_[op] = 0;
+      totalNs_[op] = 0;
+      for(uint32_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+      {
+        latency_[op][bucket] = 0;
+      }
+    }
+  }
+
+  /**
+   * Return the bucket counting a latency of ns nanoseconds
+   */
+  static uint32_t latencyBucket(uint64_t ns)
+  {
+    uint32_t bucket(0);
+    while(ns > 1 && bucket < LATENCY_BUCKETS - 1)
+    {
+      ns >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  /**
+   * Write the statistics in a readable format, only the operations that were used
+   */
+  void dump(std::ostream &out) const
+  {
+    out << "size=" << size_ << ", peak size=" << peakSize_
+        << ", bytes in use=" << bytesInUse_ << ", peak bytes in use=" << peakBytesInUse_ << "\n"
+        << "nodes allocated=" << nodesAllocated_ << ", nodes freed=" << nodesFreed_ << "\n"
+        << "pop_back walks=" << popBackWalks_ << ", walk steps=" << popBackWalkSteps_
+        << ", longest walk=" << maxPopBackWalk_ << "\n"
+        << "empty list exceptions=" << emptyThrows_ << "\n";
+
+    for(uint32_t op = 0; op < LIST_OP_COUNT; ++op)
+    {
+      if(opCounts_[op] == 0)
+      {
+        continue;
+      }
+
+      out << listOpName(ListOp(op)) << ": count=" << opCounts_[op]
+          << ", mean ns=" << totalNs_[op] / opCounts_[op] << ", latency ns histogram:";
+      for(uint32_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+      {
+        if(latency_[op][bucket] != 0)
+        {
+          out << " [" << (bucket == 0 ? 0 : uint64_t(1) << bucket) << ")=" << latency_[op][bucket];
+        }
+      }
+      out << "\n";
+    }
+  }
+
+  uint32_t size_;
+  uint32_t peakSize_;
+  uint64_t bytesInUse_;
+  uint64_t peakBytesInUse_;
+  uint64_t nodesAllocated_;
+  uint64_t nodesFreed_;
+  uint64_t popBackWalks_;
+  uint64_t popBackWalkSteps_;
+  uint32_t maxPopBackWalk_;
+  uint64_t emptyThrows_;
+  uint64_t opCounts_[LIST_OP_COUNT];
+  uint64_t totalNs_[LIST_OP_COUNT];
+  uint64_t latency_[LIST_OP_COUNT][LATENCY_BUCKETS];
+};
+
+/**
+ * Counts every operation and its latency, the node allocations, the size
+ * and memory used by the list, the pop_back() walks and the exceptions
+ * thrown on an empty list. Like the list, it's not thread safe.
+ * Each operation is timed with the steady clock, which costs tens of ns.
+ */
+class CountingStats
+{
+public:
+  typedef int64_t Timing;
+
+  CountingStats() : depth_(0) {}
+
+  Timing startOp() { return ++depth_ == 1 ? nowNs() : 0; }
+
+  void endOp(ListOp op, Timing start, uint32_t size, std::size_t nodeBytes)
+  {
+    if(--depth_ > 0)
+    {
+      // Nested in another operation, which is the one counted
+      return;
+    }
+
+    uint64_t ns(nowNs() - start);
+    ++stats_.opCounts_[op];
+    stats_.totalNs_[op] += ns;
+    ++stats_.latency_[op][ListStatsSnapshot::latencyBucket(ns)];
+
+    stats_.size_ = size;
+    stats_.bytesInUse_ = uint64_t(size) * nodeBytes;
+    if(size > stats_.peakSize_)
+    {
+      stats_.peakSize_ = size;
+      stats_.peakBytesInUse_ = stats_.bytesInUse_;
+    }
+  }
+
+  void nodesAllocated(uint32_t count) { stats_.nodesAllocated_ += count; }
+  void nodesFreed(uint32_t count) { stats_.nodesFreed_ += count; }
+
+  void popBackWalked(uint32_t steps)
+  {
+    ++stats_.popBackWalks_;
+    stats_.popBackWalkSteps_ += steps;
+    if(steps > stats_.maxPopBackWalk_)
+    {
+      stats_.maxPopBackWalk_ = steps;
+    }
+  }
+
+  void emptyThrown() const { ++stats_.emptyThrows_; }
+
+  /**
+   * Return a copy of the statistics collected so far
+   */
+  ListStatsSnapshot snapshot() const { return stats_; }
+
+  /**
+   * Write the statistics collected so far in a readable format
+   */
+  void dump(std::ostream &out) const { stats_.dump(out); }
+
+private:
+  static int64_t nowNs()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  mutable ListStatsSnapshot stats_;
+  uint32_t depth_;
+};
+
+#endif /* LISTSTATS_HH_ */
@@ -0,0 +1,620 @@
+/*
+ * ListStream.hh
+ *
+ * Streaming writers and readers of lists, over pipes, sockets and files
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef LISTSTREAM_HH_
+#define LISTSTREAM_HH_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <stdint.h>
+
+#include <unistd.h>
+
+#include "ListPolicies.hh"
+
+/**
+ * The default size of the stream buffers: each read() or write() call transfers up to this many bytes
+ */
+static const std::size_t LIST_STREAM_BUFFER_SIZE = 1 << 16;
+
+/**
+ * The longest element in the text format, in chars
+ */
+static const std::size_t LIST_STREAM_TEXT_MAX = 64;
+
+/**
+ * The formats of the list streams
+ */
+enum ListStreamFormat
+{
+  // A 16-byte header, then the bytes of the elements, which must be trivially copyable
+  LIST_STREAM_BINARY,
+
+  // The elements in decimal, one per line, only for numbers. The reader accepts any whitespace between them.
+  LIST_STREAM_TEXT
+};
+
+/**
+ * Throw an std::system_error for errno, what being the failed operation
+ */
+inline void listThrowErrno(const std::string &what)
+{
+  LIST_THROW(std::system_error(errno, std::generic_category(), what));
+}
+
+/**
+ * Write bytes bytes to fd, even if the writes are partial, what being the operation
+ * reported in the std::system_error thrown if writing fails
+ */
+inline void listWriteAll(int fd, const char *data, std::size_t bytes, const std::string &what)
+{
+  while(bytes > 0)
+  {
+    ssize_t written(::write(fd, data, bytes));
+    if(written < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if(written < 0)
+    {
+      listThrowErrno(what);
+    }
+    data += written;
+    bytes -= written;
+  }
+}
+
+/**
+ * The text conversions of the elements, only numbers have one
+ */
+template <class T, bool Integral = std::is_integral<T>::value, bool Floating = std::is_floating_point<T>::value>
+struct ListStreamText
+{
+  static const bool SUPPORTED = false;
+  static std::size_t format(char *, const T &) { return 0; }
+  static bool parse(const char *, const char *, T &) { return false; }
+};
+
+template <class T>
+struct ListStreamText<T, true, false>
+{
+  static const bool SUPPORTED = true;
+
+  /**
+   * Write value in decimal at out, return the number of chars written
+   */
+  static std::size_t format(char *out, T value)
+  {
+    char digits[24];
+    std::size_t count(0);
+    bool negative(value < T(0));
+    uint64_t magnitude(negative ? uint64_t(0) - uint64_t(value) : uint64_t(value));
+    do
+    {
+      digits[count++] = char('0' + magnitude % 10);
+      magnitude /= 10;
+    } while(magnitude != 0);
+
+    std::size_t written(0);
+    if(negative)
+    {
+      out[written++] = '-';
+    }
+    while(count > 0)
+    {
+      out[written++] = digits[--count];
+    }
+    return written;
+  }
+
+  /**
+   * Parse [first, last) as a decimal number, return false if it's not one or doesn't fit in T
+   */
+  static bool parse(const char *first, const char *last, T &value)
+  {
+    bool negative(first != last && *first == '-');
+    if(first != last && (*first == '-' || *first == '+'))
+    {
+      ++first;
+    }
+    if(first == last)
+    {
+      return false;
+    }
+
+    uint64_t limit(negative ? (std::is_signed<T>::value ? uint64_t(std::numeric_limits<T>::max()) + 1 : 0)
+                            : uint64_t(std::numeric_limits<T>::max()));
+    uint64_t magnitude(0);
+    for(; first != last; ++first)
+    {
+      unsigned digit(unsigned(*first) - '0');
+      if(digit > 9 || magnitude > limit / 10 || (magnitude == limit / 10 && digit > limit % 10))
+      {
+        return false;
+      }
+      magnitude = magnitude * 10 + digit;
+    }
+
+    value = (negative && magnitude != 0 ? T(-int64_t(magnitude - 1) - 1) : T(magnitude));
+    return true;
+  }
+};
+
+template <class T>
+struct ListStreamText<T, false, true>
+{
+  static const bool SUPPORTED = true;
+
+  /**
+   * Write value at out, with enough digits to parse it back exactly, return the number of chars written
+   */
+  static std::size_t format(char *out, T value)
+  {
+    return std::snprintf(out, LIST_STREAM_TEXT_MAX, "%.*Lg", std::numeric_limits<T>::max_digits10, (long double)value);
+  }
+
+  /**
+   * Parse [first, last) as a number, return false if it's not one
+   */
+  static bool parse(const char *first, const char *last, T &value)
+  {
+    // strto*() need a terminated string
+    char text[LIST_STREAM_TEXT_MAX + 1];
+    std::size_t length(last - first);
+    if(length == 0 || length > LIST_STREAM_TEXT_MAX)
+    {
+      return false;
+    }
+    std::memcpy(text, first, length);
+    text[length] = '\0';
+
+    char *end;
+    value = toNumber(text, &end, T());
+    return end == text + length;
+  }
+
+private:
+  static float toNumber(const char *text, char **end, float) { return std::strtof(text, end); }
+  static double toNumber(const char *text, char **end, double) { return std::strtod(text, end); }
+  static long double toNumber(const char *text, char **end, long double) { return std::strtold(text, end); }
+};
+
+/**
+ * Iterator over elements stored as bytes, each one copied out when dereferenced,
+ * since the bytes aren't objects of type T
+ */
+template <class T>
+class ListStreamBytesIterator
+{
+public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef T value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const T* pointer;
+  typedef T reference;
+
+  explicit ListStreamBytesIterator(const char *bytes) : bytes_(bytes) {}
+  bool operator==(ListStreamBytesIterator rhs) const { return rhs.bytes_ == bytes_; }
+  bool operator!=(ListStreamBytesIterator rhs) const { return rhs.bytes_ != bytes_; }
+  T operator*() const
+  {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+    std::memcpy(&value, bytes_, sizeof(T));
+    return *reinterpret_cast<T*>(&value);
+  }
+  ListStreamBytesIterator &operator++() { bytes_ += sizeof(T); return *this; }
+  ListStreamBytesIterator operator++(int unused) { ListStreamBytesIterator retval(*this); bytes_ += sizeof(T); return retval; }
+private:
+  const char *bytes_;
+};
+
+/**
+ * The header of the binary streams: magic, version and element size
+ */
+struct ListStreamHeader
+{
+  static const std::size_t SIZE = 16;
+  static const uint32_t VERSION = 1;
+  static const char *magic() { return "SLLSTRM\n"; }
+
+  /**
+   * Write the header of a stream of elements of elementSize bytes at out
+   */
+  static void write(char *out, uint32_t elementSize)
+  {
+    uint32_t version(VERSION);
+    std::memcpy(out, magic(), 8);
+    std::memcpy(out + 8, &version, sizeof(version));
+    std::memcpy(out + 12, &elementSize, sizeof(elementSize));
+  }
+
+  /**
+   * Check the header at in, throw an std::invalid_argument exception if it's not one of elementSize bytes elements
+   */
+  static void check(const char *in, uint32_t elementSize)
+  {
+    uint32_t version;
+    uint32_t size;
+    std::memcpy(&version, in + 8, sizeof(version));
+    std::memcpy(&size, in + 12, sizeof(size));
+    if(std::memcmp(in, magic(), 8) != 0 || version != VERSION)
+    {
+      LIST_THROW(std::invalid_argument("not a list stream"));
+    }
+    if(size != elementSize)
+    {
+      LIST_THROW(std::invalid_argument("the list stream has elements of another type"));
+    }
+  }
+};
+
+/**
+ * Write the elements of lists to a file descriptor, as they're iterated: they're
+ * formatted into a buffer, written with one write() call once it's full.
+ * The descriptor isn't closed. Writing to a closed pipe raises SIGPIPE, which
+ * kills the process unless it's ignored. Not thread safe.
+ */
+template <class T>
+class ListStreamWriter
+{
+private:
+  typedef ListStreamText<T> Text;
+
+public:
+  /**
+   * Write to fd in format, through a buffer of about bufferSize bytes.
+   * The text format is only available for numbers, otherwise an
+   * std::invalid_argument exception is thrown.
+   */
+  ListStreamWriter(int fd, ListStreamFormat format = LIST_STREAM_BINARY, std::size_t bufferSize = LIST_STREAM_BUFFER_SIZE) :
+    fd_(fd),
+    format_(format),
+    buffer_(bufferSize < MIN_BUFFER ? std::size_t(MIN_BUFFER) : bufferSize),
+    used_(0),
+    written_(0)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "the elements must be trivially copyable");
+    if(format == LIST_STREAM_TEXT && !Text::SUPPORTED)
+    {
+      LIST_THROW(std::invalid_argument("only numbers can be streamed as text"));
+    }
+
+    // An empty list is still a valid stream
+    if(format == LIST_STREAM_BINARY)
+    {
+      ListStreamHeader::write(&buffer_[0], sizeof(T));
+      used_ = ListStreamHeader::SIZE;
+    }
+  }
+
+  /**
+   * Flush the buffer, the errors are ignored: call flush() to get them
+   */
+  ~ListStreamWriter()
+  {
+    LIST_TRY
+    {
+      flush();
+    }
+    LIST_CATCH_ALL
+    {
+    }
+  }
+
+  /**
+   * Write one element, the buffer is flushed if it's full.
+   * Throws an std::system_error if writing fails.
+   */
+  void write(const T &value)
+  {
+    if(format_ == LIST_STREAM_BINARY)
+    {
+      if(used_ + sizeof(T) > buffer_.size())
+      {
+        flush();
+      }
+      std::memcpy(&buffer_[used_], &value, sizeof(T));
+      used_ += sizeof(T);
+    }
+    else
+    {
+      if(used_ + LIST_STREAM_TEXT_MAX + 1 > buffer_.size())
+      {
+        flush();
+      }
+      used_ += Text::format(&buffer_[used_], value);
+      buffer_[used_++] = '\n';
+    }
+  }
+
+  /**
+   * Write all the elements of list, in order. ListType is a list of T, like a SimpleLinkedList<T>.
+   */
+  template <class ListType>
+  void write_all(const ListType &list)
+  {
+    if(list.empty())
+    {
+      return;
+    }
+
+    for(typename ListType::const_iterator iter = list.begin(); iter != list.end(); iter.increment())
+    {
+      write(*iter);
+    }
+  }
+
+  /**
+   * Write the buffered elements now.
+   * Throws an std::system_error if writing fails.
+   */
+  void flush()
+  {
+    if(used_ > 0)
+    {
+      listWriteAll(fd_, &buffer_[0], used_, "can't write the list stream");
+      written_ += used_;
+      used_ = 0;
+    }
+  }
+
+  /**
+   * Return the number of bytes written so far, not counting the buffered ones
+   */
+  uint64_t bytes_written() const { return written_; }
+
+private:
+
+  ListStreamWriter(const ListStreamWriter &);
+  ListStreamWriter &operator=(const ListStreamWriter &);
+
+  // Room for the header and an element
+  static const std::size_t MIN_BUFFER = ListStreamHeader::SIZE + LIST_STREAM_TEXT_MAX + sizeof(T);
+
+  int fd_;
+  ListStreamFormat format_;
+  std::vector<char> buffer_;
+  std::size_t used_;
+  uint64_t written_;
+};
+
+/**
+ * Read the elements written by a ListStreamWriter from a file descriptor,
+ * appending them to lists as they arrive: read_some() makes one read()
+ * call, parses the complete elements in the buffer, and appends them with
+ * one append_range() call, which allocates their nodes in bulk. Incomplete
+ * elements are kept until the rest of them is read. The descriptor isn't
+ * closed. Not thread safe.
+ */
+template <class T>
+class ListStreamReader
+{
+private:
+  typedef ListStreamText<T> Text;
+
+public:
+  /**
+   * Read from fd in format, through a buffer of about bufferSize bytes.
+   * The text format is only available for numbers, otherwise an
+   * std::invalid_argument exception is thrown.
+   */
+  ListStreamReader(int fd, ListStreamFormat format = LIST_STREAM_BINARY, std::size_t bufferSize = LIST_STREAM_BUFFER_SIZE) :
+    fd_(fd),
+    format_(format),
+    buffer_(bufferSize < MIN_BUFFER ? std::size_t(MIN_BUFFER) : bufferSize),
+    begin_(0),
+    end_(0),
+    read_(0),
+    header_(format != LIST_STREAM_BINARY),
+    eof_(false)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "the elements must be trivially copyable");
+    if(format == LIST_STREAM_TEXT && !Text::SUPPORTED)
+    {
+      LIST_THROW(std::invalid_argument("only numbers can be streamed as text"));
+    }
+  }
+
+  /**
+   * Read the bytes available, up to the buffer size, and append the complete
+   * elements to list, which must provide append_range(), like a SimpleLinkedList<T>.
+   * Return the number of elements appended. With a non-blocking descriptor,
+   * 0 is returned if no bytes are available.
+   * Throws an std::system_error if reading fails, or an std::invalid_argument
+   * exception if the stream is malformed or ends in the middle of an element.
+   */
+  template <class ListType>
+  uint32_t read_some(ListType &list)
+  {
+    if(eof_)
+    {
+      return 0;
+    }
+
+    // Move the incomplete element to the start of the buffer
+    if(begin_ > 0)
+    {
+      std::memmove(&buffer_[0], &buffer_[begin_], end_ - begin_);
+      end_ -= begin_;
+      begin_ = 0;
+    }
+
+    ssize_t count;
+    do
+    {
+      count = ::read(fd_, &buffer_[end_], buffer_.size() - end_);
+    } while(count < 0 && errno == EINTR);
+    if(count < 0)
+    {
+      if(errno == EAGAIN || errno == EWOULDBLOCK)
+      {
+        return 0;
+      }
+      listThrowErrno("can't read the list stream");
+    }
+    eof_ = (count == 0);
+    end_ += count;
+    read_ += count;
+
+    if(format_ == LIST_STREAM_BINARY)
+    {
+      return parseBinary(list);
+    }
+    return parseText(list, std::integral_constant<bool, Text::SUPPORTED>());
+  }
+
+  /**
+   * Read until the end of the stream, appending the elements to list, see read_some().
+   * Return the number of elements appended.
+   */
+  template <class ListType>
+  uint64_t read_all(ListType &list)
+  {
+    uint64_t total(0);
+    while(!eof_)
+    {
+      total += read_some(list);
+    }
+    return total;
+  }
+
+  /**
+   * Return true once the end of the stream is reached
+   */
+  bool eof() const { return eof_; }
+
+  /**
+   * Return the number of bytes read so far
+   */
+  uint64_t bytes_read() const { return read_; }
+
+private:
+
+  ListStreamReader(const ListStreamReader &);
+  ListStreamReader &operator=(const ListStreamReader &);
+
+  // Room for the header and two elements, so that a complete element always fits after an incomplete one
+  static const std::size_t MIN_BUFFER = ListStreamHeader::SIZE + 2 * (LIST_STREAM_TEXT_MAX + sizeof(T));
+
+  /**
+   * Internal method to append the complete binary elements to list, straight from the buffer
+   */
+  template <class ListType>
+  uint32_t parseBinary(ListType &list)
+  {
+    if(!header_)
+    {
+      if(end_ - begin_ < ListStreamHeader::SIZE)
+      {
+        if(eof_)
+        {
+          LIST_THROW(std::invalid_argument("the list stream is truncated"));
+        }
+        return 0;
+      }
+      ListStreamHeader::check(&buffer_[begin_], sizeof(T));
+      begin_ += ListStreamHeader::SIZE;
+      header_ = true;
+    }
+
+    std::size_t count((end_ - begin_) / sizeof(T));
+    if(count > 0)
+    {
+      const char *first(&buffer_[begin_]);
+      list.append_range(ListStreamBytesIterator<T>(first), ListStreamBytesIterator<T>(first + count * sizeof(T)));
+      begin_ += count * sizeof(T);
+    }
+    if(eof_ && begin_ != end_)
+    {
+      LIST_THROW(std::invalid_argument("the list stream is truncated"));
+    }
+    return count;
+  }
+
+  /**
+   * Internal method to parse the complete text elements, and append them to list
+   */
+  template <class ListType>
+  uint32_t parseText(ListType &, std::false_type)
+  {
+    return 0;
+  }
+
+  template <class ListType>
+  uint32_t parseText(ListType &list, std::true_type)
+  {
+    const char *data(&buffer_[0]);
+    batch_.clear();
+    std::size_t position(begin_);
+    while(true)
+    {
+      while(position < end_ && isSpace(data[position]))
+      {
+        ++position;
+      }
+      if(position == end_)
+      {
+        break;
+      }
+
+      std::size_t last(position);
+      while(last < end_ && !isSpace(data[last]))
+      {
+        ++last;
+      }
+      if(last - position > LIST_STREAM_TEXT_MAX)
+      {
+        LIST_THROW(std::invalid_argument("the list stream has an element too long"));
+      }
+      if(last == end_ && !eof_)
+      {
+        // The rest of the element isn't read yet
+        break;
+      }
+
+      T value;
+      if(!Text::parse(data + position, data + last, value))
+      {
+        LIST_THROW(std::invalid_argument("the list stream has a malformed element: " + std::string(data + position, data + last)));
+      }
+      batch_.push_back(value);
+      position = last;
+    }
+    begin_ = position;
+
+    if(!batch_.empty())
+    {
+      list.append_range(batch_.begin(), batch_.end());
+    }
+    return batch_.size();
+  }
+
+  static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r'; }
+
+  int fd_;
+  ListStreamFormat format_;
+  std::vector<char> buffer_;
+  std::vector<T> batch_;
+  std::size_t begin_;  // the first byte not parsed yet
+  std::size_t end_;    // the end of the bytes read
+  uint64_t read_;
+  bool header_;        // true once the binary header is read
+  bool eof_;
+};
+
+#endif /* LISTSTREAM_HH_ */
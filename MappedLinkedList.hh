@@ -0,0 +1,424 @@
+/*
+ * MappedLinkedList.hh
+ *
+ * A persistent list format, reopened with mmap without deserializing it
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef MAPPEDLINKEDLIST_HH_
+#define MAPPEDLINKEDLIST_HH_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <stdint.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ListPolicies.hh"
+#include "ListStream.hh"
+
+/**
+ * How a MappedLinkedList maps its file
+ */
+enum ListMapMode
+{
+  // The elements can only be read, the pages are shared with the other processes mapping the file
+  LIST_MAP_READ_ONLY,
+
+  // The elements can be modified, the modified pages are copied and never written to the file
+  LIST_MAP_COPY_ON_WRITE
+};
+
+/**
+ * A single LinkedList of trivially copyable elements, stored in a file, and
+ * used in place through a memory mapping: opening it only reads the header,
+ * the nodes are loaded from the file, or the page cache, when they're first
+ * accessed. The nodes link to each other with their offset in the file, so
+ * the format doesn't depend on the address it's mapped at. save() writes
+ * a list in list order, so following the links reads the file sequentially.
+ *
+ * The mapped list can't grow, it can only be iterated, have its elements
+ * modified if mapped copy-on-write, and be popped from the front, which
+ * doesn't modify the file either. Writing to an element of a list mapped
+ * read-only is a segmentation fault. The file is trusted: its header is
+ * checked, but the links aren't, and the elements must have been saved by
+ * a program with the same layout for T.
+ */
+template <class T>
+class MappedLinkedList
+{
+private:
+  static_assert(std::is_trivially_copyable<T>::value, "the elements must be trivially copyable");
+
+  /**
+   * Internal class used to store the data in the file, next_ is the offset of the next node, 0 at the end
+   */
+  struct ListNode
+  {
+    T data_;
+    uint64_t next_;
+  };
+
+  /**
+   * The file starts with this header, padded to HEADER_SIZE bytes, then come the nodes
+   */
+  struct FileHeader
+  {
+    char magic_[8];
+    uint32_t version_;
+    uint32_t nodeSize_;
+    uint32_t dataSize_;
+    uint32_t dataAlign_;
+    uint32_t size_;
+    uint32_t reserved_;
+    uint64_t head_;
+    uint64_t tail_;
+    uint64_t fileSize_;
+  };
+
+  static const std::size_t HEADER_SIZE = 64;
+  static const uint32_t VERSION = 1;
+  static_assert(sizeof(FileHeader) <= HEADER_SIZE, "the header must fit in HEADER_SIZE bytes");
+  static_assert(HEADER_SIZE % alignof(ListNode) == 0, "over-aligned elements are not supported");
+
+  static const char *magic() { return "SLLMAP\r\n"; }
+
+  /**
+   * Internal class used to iterate the Linked List
+   */
+  class ListIterator
+  {
+  public:
+    ListIterator() : base_(NULL), offset_(0) {}
+    ListIterator(char *base, uint64_t offset) : base_(base), offset_(offset) {}
+    bool operator==(ListIterator rhs) const { return rhs.offset_ == offset_; }
+    bool operator!=(ListIterator rhs) const { return rhs.offset_ != offset_; }
+    T * operator->() const { return &(node()->data_); }
+    T & operator*() const { return node()->data_; }
+    void increment() { offset_ = node()->next_; }
+    ListIterator &operator++() { increment(); return *this; }
+    ListIterator operator++(int unused) { ListIterator retval(*this); increment(); return retval; }
+  private:
+    ListNode *node() const { return reinterpret_cast<ListNode*>(base_ + offset_); }
+    char *base_;
+    uint64_t offset_;
+  };
+
+public:
+  typedef ListIterator iterator;
+  typedef ListIterator const_iterator;
+
+  /**
+   * Construct a list without any file, open() maps one
+   */
+  MappedLinkedList() :
+    base_(NULL),
+    mapped_(0),
+    head_(0),
+    tail_(0),
+    size_(0),
+    mode_(LIST_MAP_READ_ONLY)
+  {
+  }
+
+  /**
+   * Map the list saved in the file path, see open()
+   */
+  MappedLinkedList(const std::string &path, ListMapMode mode = LIST_MAP_READ_ONLY) :
+    base_(NULL),
+    mapped_(0),
+    head_(0),
+    tail_(0),
+    size_(0),
+    mode_(mode)
+  {
+    open(path, mode);
+  }
+
+  ~MappedLinkedList()
+  {
+    close();
+  }
+
+  /**
+   * Write list in the file path, replacing it, in list order. ListType is a list
+   * of T, like a SimpleLinkedList<T>. Throws an std::system_error if writing fails.
+   * The list is written to a temporary file next to path, synced, then renamed
+   * over path: the lists still mapping the previous file keep it, and if writing
+   * fails, the previous file is left as it was.
+   * Algorithmic complexity = O(n), the nodes are written in blocks
+   */
+  template <class ListType>
+  static void save(const ListType &list, const std::string &path)
+  {
+    std::vector<char> tempPath(path.begin(), path.end());
+    const char suffix[] = ".tmp.XXXXXX";
+    tempPath.insert(tempPath.end(), suffix, suffix + sizeof(suffix));
+    int fd(::mkstemp(&tempPath[0]));
+    if(fd < 0)
+    {
+      listThrowErrno("can't create " + path);
+    }
+
+    // The padding bytes are written as zeros
+    std::vector<char> buffer(HEADER_SIZE + BLOCK_NODES * sizeof(ListNode), 0);
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic_, magic(), sizeof(header.magic_));
+    header.version_ = VERSION;
+    header.nodeSize_ = sizeof(ListNode);
+    header.dataSize_ = sizeof(T);
+    header.dataAlign_ = alignof(T);
+    header.size_ = list.size();
+    header.head_ = (list.empty() ? 0 : HEADER_SIZE);
+    header.tail_ = (list.empty() ? 0 : HEADER_SIZE + uint64_t(list.size() - 1) * sizeof(ListNode));
+    header.fileSize_ = HEADER_SIZE + uint64_t(list.size()) * sizeof(ListNode);
+    std::memcpy(&buffer[0], &header, sizeof(header));
+
+    std::size_t used(HEADER_SIZE);
+    uint64_t offset(HEADER_SIZE);
+    uint32_t written(0);
+    LIST_TRY
+    {
+      if(!list.empty())
+      {
+        for(typename ListType::const_iterator iter = list.begin(); iter != list.end(); iter.increment())
+        {
+          if(used + sizeof(ListNode) > buffer.size())
+          {
+            listWriteAll(fd, &buffer[0], used, "can't write " + path);
+            used = 0;
+          }
+
+          ListNode *node(reinterpret_cast<ListNode*>(&buffer[used]));
+          std::memcpy(&node->data_, &(*iter), sizeof(T));
+          offset += sizeof(ListNode);
+          node->next_ = (++written == header.size_ ? 0 : offset);
+          used += sizeof(ListNode);
+        }
+      }
+      listWriteAll(fd, &buffer[0], used, "can't write " + path);
+
+      // mkstemp() creates the file only readable by its owner
+      if(::fchmod(fd, 0644) != 0 || ::fsync(fd) != 0)
+      {
+        listThrowErrno("can't write " + path);
+      }
+    }
+    LIST_CATCH_ALL
+    {
+      ::close(fd);
+      ::unlink(&tempPath[0]);
+      LIST_RETHROW;
+    }
+
+    if(::close(fd) != 0 || ::rename(&tempPath[0], path.c_str()) != 0)
+    {
+      int error(errno);
+      ::unlink(&tempPath[0]);
+      errno = error;
+      listThrowErrno("can't write " + path);
+    }
+  }
+
+  /**
+   * Map the list saved in the file path, closing the current one. The file
+   * can be removed, or replaced by save(), once mapped, but must not be
+   * modified or truncated.
+   * Throws an std::system_error if the file can't be mapped, or an
+   * std::invalid_argument exception if it's not a list of T.
+   */
+  void open(const std::string &path, ListMapMode mode = LIST_MAP_READ_ONLY)
+  {
+    close();
+
+    int fd(::open(path.c_str(), O_RDONLY));
+    if(fd < 0)
+    {
+      listThrowErrno("can't open " + path);
+    }
+
+    struct stat info;
+    if(::fstat(fd, &info) != 0)
+    {
+      int error(errno);
+      ::close(fd);
+      LIST_THROW(std::system_error(error, std::generic_category(), "can't read " + path));
+    }
+    if(uint64_t(info.st_size) < HEADER_SIZE)
+    {
+      ::close(fd);
+      LIST_THROW(std::invalid_argument(path + " is not a mapped list"));
+    }
+
+    void *base(::mmap(NULL, info.st_size,
+                      mode == LIST_MAP_READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE,
+                      mode == LIST_MAP_READ_ONLY ? MAP_SHARED : MAP_PRIVATE, fd, 0));
+    int error(errno);
+    ::close(fd);
+    if(base == MAP_FAILED)
+    {
+      LIST_THROW(std::system_error(error, std::generic_category(), "can't map " + path));
+    }
+
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    const char *problem(NULL);
+    if(std::memcmp(header.magic_, magic(), sizeof(header.magic_)) != 0 || header.version_ != VERSION)
+    {
+      problem = " is not a mapped list";
+    }
+    else if(header.nodeSize_ != sizeof(ListNode) || header.dataSize_ != sizeof(T) || header.dataAlign_ != alignof(T))
+    {
+      problem = " has elements of another type";
+    }
+    else if(header.fileSize_ != uint64_t(info.st_size) ||
+            (header.size_ == 0) != (header.head_ == 0) ||
+            !validOffset(header.head_, info.st_size) || !validOffset(header.tail_, info.st_size))
+    {
+      problem = " is truncated or corrupted";
+    }
+    if(problem != NULL)
+    {
+      ::munmap(base, info.st_size);
+      LIST_THROW(std::invalid_argument(path + problem));
+    }
+
+    base_ = static_cast<char*>(base);
+    mapped_ = info.st_size;
+    head_ = header.head_;
+    tail_ = header.tail_;
+    size_ = header.size_;
+    mode_ = mode;
+  }
+
+  /**
+   * Unmap the file, emptying the list. The elements modified copy-on-write are lost.
+   */
+  void close()
+  {
+    if(base_ != NULL)
+    {
+      ::munmap(base_, mapped_);
+    }
+    base_ = NULL;
+    mapped_ = 0;
+    head_ = tail_ = 0;
+    size_ = 0;
+  }
+
+  /**
+   * Return true if a file is mapped
+   */
+  bool is_open() const { return base_ != NULL; }
+
+  /**
+   * Return true if the elements can be modified, the file being mapped copy-on-write
+   */
+  bool writable() const { return base_ != NULL && mode_ == LIST_MAP_COPY_ON_WRITE; }
+
+  /**
+   * Return an iterator to the beginning of the Linked List.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator begin() const { emptyException(); return ListIterator(base_, head_); }
+
+  /**
+   * Return an iterator indicating the end of the Linked List has been reached
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator end() const { emptyException(); return ListIterator(); }
+
+  /**
+   * Return the number of elements in the linked list
+   */
+  inline uint32_t size() const { return size_; }
+
+  /**
+   * Return true if the list is empty, false otherwise
+   */
+  inline bool empty() const { return size_ == 0; }
+
+  /**
+   * Remove the element from the head of the Linked list, the file isn't modified
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    emptyException();
+
+    head_ = node(head_)->next_;
+    if(--size_ == 0)
+    {
+      tail_ = 0;
+    }
+  }
+
+  /**
+   * Return the first element in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &front() const { emptyException(); return node(head_)->data_; }
+
+  /**
+   * Return the last element in the Linked List without modifying the list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &back() const { emptyException(); return node(tail_)->data_; }
+
+private:
+
+  /*
+   * Copying would share the mapping, and the dtor would unmap it twice
+   */
+  MappedLinkedList(const MappedLinkedList &);
+  MappedLinkedList &operator=(const MappedLinkedList &);
+
+  /**
+   * The number of nodes save() writes at once
+   */
+  static const std::size_t BLOCK_NODES = 4096;
+
+  ListNode *node(uint64_t offset) const { return reinterpret_cast<ListNode*>(base_ + offset); }
+
+  /**
+   * Internal method to check offset is 0, or the offset of a node in a file of fileSize bytes
+   */
+  static bool validOffset(uint64_t offset, uint64_t fileSize)
+  {
+    return offset == 0 ||
+           (offset >= HEADER_SIZE && (offset - HEADER_SIZE) % sizeof(ListNode) == 0 && offset + sizeof(ListNode) <= fileSize);
+  }
+
+  /**
+   * Internal method to check if the Linked List is empty.
+   * Throws a std::length_error exception if it is empty
+   */
+  void emptyException() const
+  {
+    if(empty())
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+  }
+
+  char *base_;
+  std::size_t mapped_;
+  uint64_t head_;
+  uint64_t tail_;
+  uint32_t size_;
+  ListMapMode mode_;
+};
+
+#endif /* MAPPEDLINKEDLIST_HH_ */
@@ -0,0 +1,404 @@
+/*
+ * NodeAllocator.hh
+ *
+ * Node allocators that can be plugged into the SimpleLinkedList
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef NODEALLOCATOR_HH_
+#define NODEALLOCATOR_HH_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <stdint.h>
+
+/*
+ * A node allocator hands out raw, uninitialized memory for exactly one
+ * node at a time. The list constructs and destroys the node itself.
+ * Every node allocator has to provide the following:
+ *
+ *   template <class U> struct rebind { typedef ... other; };
+ *   T *allocate();
+ *   T *allocate_contiguous(std::size_t n);
+ *   void deallocate(T *p);
+ *   bool can_release() const;
+ *   void release();
+ *   bool operator==(const Allocator &) const;
+ *   bool operator!=(const Allocator &) const;
+ *
+ * allocate_contiguous() returns an array of n nodes in one contiguous
+ * block, which can still be deallocated one node at a time, or NULL if
+ * the allocator can't do it, in which case the nodes are allocated one
+ * at a time. can_release() returns true when release() may be used to
+ * free every node handed out by the allocator at once, instead of
+ * deallocating them one at a time.
+ * Allocators compare equal when they can deallocate each other's nodes:
+ * lists with equal allocators exchange their nodes, otherwise the
+ * elements are moved into new nodes one by one.
+ */
+
+/**
+ * The default node allocator: each node is individually allocated on the heap.
+ */
+template <class T>
+class HeapAllocator
+{
+public:
+  template <class U> struct rebind { typedef HeapAllocator<U> other; };
+
+  HeapAllocator() {}
+  template <class U> HeapAllocator(const HeapAllocator<U> &) {}
+
+  T *allocate() { return static_cast<T*>(::operator new(sizeof(T))); }
+  void deallocate(T *p) { ::operator delete(p); }
+
+  /**
+   * Heap nodes have to be deallocated one at a time,
+   * so they can't be carved from one contiguous block
+   */
+  T *allocate_contiguous(std::size_t) { return NULL; }
+
+  /**
+   * Heap nodes can only be freed one at a time
+   */
+  bool can_release() const { return false; }
+  void release() {}
+
+  bool operator==(const HeapAllocator &) const { return true; }
+  bool operator!=(const HeapAllocator &) const { return false; }
+};
+
+/**
+ * A slab/arena node allocator. Nodes are carved from contiguous blocks
+ * (slabs) of SlabNodes nodes, or bigger for large contiguous allocations,
+ * and deallocated nodes are recycled through a free list. The allocator is a lightweight handle on a shared pool:
+ * copies of the allocator use the same pool, which is freed when the last
+ * handle is destroyed. Not thread safe.
+ */
+template <class T, std::size_t SlabNodes = 512>
+class PoolAllocator
+{
+private:
+  /**
+   * Internal storage for one node, reused as a free list link once deallocated
+   */
+  union Slot
+  {
+    Slot *nextFree_;
+    alignas(T) char storage_[sizeof(T)];
+  };
+
+  /**
+   * Internal header of one contiguous block of nodes, the capacity_ slots follow it
+   */
+  struct Slab
+  {
+    Slab *next_;
+    std::size_t capacity_;
+    Slot *slots() { return reinterpret_cast<Slot*>(reinterpret_cast<char*>(this) + HEADER_SIZE); }
+  };
+
+  static const std::size_t HEADER_SIZE = (sizeof(Slab) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+  static_assert(alignof(Slot) <= alignof(std::max_align_t), "over-aligned nodes are not supported");
+
+  /**
+   * Internal state shared by all the copies of one PoolAllocator
+   */
+  struct Pool
+  {
+    Pool() : refs_(1), slabs_(NULL), freeList_(NULL), carved_(0), inUse_(0) {}
+    uint32_t refs_;
+    Slab *slabs_;         // the slab nodes are carved from is the first one
+    Slot *freeList_;
+    std::size_t carved_;  // number of slots already carved from slabs_
+    std::size_t inUse_;
+  };
+
+public:
+  template <class U> struct rebind { typedef PoolAllocator<U, SlabNodes> other; };
+
+  PoolAllocator() : pool_(new Pool()) {}
+  PoolAllocator(const PoolAllocator &other) : pool_(other.pool_) { ++pool_->refs_; }
+
+  /**
+   * Converting from an allocator for another type creates a new, empty pool,
+   * since the slots of the other pool are not the right size
+   */
+  template <class U, std::size_t N> PoolAllocator(const PoolAllocator<U, N> &) : pool_(new Pool()) {}
+
+  PoolAllocator &operator=(const PoolAllocator &other)
+  {
+    ++other.pool_->refs_;
+    detach();
+    pool_ = other.pool_;
+    return *this;
+  }
+
+  ~PoolAllocator() { detach(); }
+
+  T *allocate()
+  {
+    Slot *slot(pool_->freeList_);
+    if(slot != NULL)
+    {
+      pool_->freeList_ = slot->nextFree_;
+    }
+    else
+    {
+      if(pool_->slabs_ == NULL || pool_->carved_ == pool_->slabs_->capacity_)
+      {
+        addSlab(SlabNodes);
+      }
+      slot = pool_->slabs_->slots() + pool_->carved_++;
+    }
+    ++pool_->inUse_;
+
+    return reinterpret_cast<T*>(slot);
+  }
+
+  /**
+   * Carve n contiguous nodes from the current slab, or from a new slab big enough.
+   * Return NULL if the slots are bigger than T, since they couldn't be used as an array of T.
+   */
+  T *allocate_contiguous(std::size_t n)
+  {
+    if(sizeof(Slot) != sizeof(T))
+    {
+      return NULL;
+    }
+
+    if(pool_->slabs_ == NULL || pool_->slabs_->capacity_ - pool_->carved_ < n)
+    {
+      addSlab(n > SlabNodes ? n : SlabNodes);
+    }
+    Slot *first(pool_->slabs_->slots() + pool_->carved_);
+    pool_->carved_ += n;
+    pool_->inUse_ += n;
+
+    return reinterpret_cast<T*>(first);
+  }
+
+  void deallocate(T *p)
+  {
+    Slot *slot(reinterpret_cast<Slot*>(p));
+    slot->nextFree_ = pool_->freeList_;
+    pool_->freeList_ = slot;
+    --pool_->inUse_;
+  }
+
+  /**
+   * The whole pool may only be released when no other handle shares it
+   */
+  bool can_release() const { return pool_->refs_ == 1; }
+
+  /**
+   * Free every node in the pool at once. The most recent slab is kept
+   * to serve the next allocations without going back to the heap.
+   */
+  void release()
+  {
+    Slab *slab(pool_->slabs_);
+    if(slab == NULL)
+    {
+      return;
+    }
+
+    Slab *spare(slab->next_);
+    while(spare != NULL)
+    {
+      Slab *next(spare->next_);
+      ::operator delete(spare);
+      spare = next;
+    }
+
+    slab->next_ = NULL;
+    pool_->freeList_ = NULL;
+    pool_->carved_ = 0;
+    pool_->inUse_ = 0;
+  }
+
+  /**
+   * Return the number of nodes currently handed out by the pool
+   */
+  std::size_t in_use() const { return pool_->inUse_; }
+
+  bool operator==(const PoolAllocator &rhs) const { return pool_ == rhs.pool_; }
+  bool operator!=(const PoolAllocator &rhs) const { return pool_ != rhs.pool_; }
+
+private:
+  /**
+   * Start carving nodes from a new slab, the slots left in the current slab are put in the free list
+   */
+  void addSlab(std::size_t capacity)
+  {
+    Slab *current(pool_->slabs_);
+    if(current != NULL)
+    {
+      for(std::size_t i = pool_->carved_; i < current->capacity_; ++i)
+      {
+        Slot *slot(current->slots() + i);
+        slot->nextFree_ = pool_->freeList_;
+        pool_->freeList_ = slot;
+      }
+    }
+
+    Slab *slab(static_cast<Slab*>(::operator new(HEADER_SIZE + capacity * sizeof(Slot))));
+    slab->next_ = current;
+    slab->capacity_ = capacity;
+    pool_->slabs_ = slab;
+    pool_->carved_ = 0;
+  }
+
+  void detach()
+  {
+    if(--pool_->refs_ == 0)
+    {
+      destroyPool(pool_);
+    }
+  }
+
+  /**
+   * Internal method to free the slabs of a pool no handle shares anymore, then the pool.
+   * Not inlined: it's the cold path, and once inlined in the destructors of several
+   * lists sharing the pool, GCC warns of a use after free it can't rule out.
+   */
+#if defined(__GNUC__)
+  __attribute__((noinline))
+#endif
+  static void destroyPool(Pool *pool)
+  {
+    while(pool->slabs_ != NULL)
+    {
+      Slab *next(pool->slabs_->next_);
+      ::operator delete(pool->slabs_);
+      pool->slabs_ = next;
+    }
+    delete pool;
+  }
+
+  Pool *pool_;
+};
+
+/**
+ * A small buffer node allocator: the first InlineNodes nodes are stored in
+ * the allocator itself, so inside the list object, and only the nodes
+ * beyond those are allocated on the heap. Short lists never touch the heap.
+ * The inline nodes can't be shared: a copy of the allocator has its own
+ * empty buffer, and only compares equal to itself, so moving or splicing
+ * such lists moves the elements one by one. Not thread safe.
+ */
+template <class T, std::size_t InlineNodes = 8>
+class InlineAllocator
+{
+public:
+  static_assert(InlineNodes > 0 && InlineNodes <= 64, "between 1 and 64 inline nodes are supported");
+
+  template <class U> struct rebind { typedef InlineAllocator<U, InlineNodes> other; };
+
+  InlineAllocator() : used_(0) {}
+  InlineAllocator(const InlineAllocator &) : used_(0) {}
+  template <class U> InlineAllocator(const InlineAllocator<U, InlineNodes> &) : used_(0) {}
+
+  /**
+   * The inline nodes stay with their allocator, assigning doesn't change them
+   */
+  InlineAllocator &operator=(const InlineAllocator &) { return *this; }
+
+  T *allocate()
+  {
+    if(used_ != FULL)
+    {
+      uint32_t slot(firstFree());
+      used_ |= uint64_t(1) << slot;
+      return reinterpret_cast<T*>(&slots_[slot]);
+    }
+
+    return static_cast<T*>(::operator new(sizeof(T)));
+  }
+
+  void deallocate(T *p)
+  {
+    // Below the buffer, the offset wraps around to a large value
+    uintptr_t offset(reinterpret_cast<uintptr_t>(p) - reinterpret_cast<uintptr_t>(slots_));
+    if(offset < sizeof(slots_))
+    {
+      used_ &= ~(uint64_t(1) << (offset / sizeof(Slot)));
+    }
+    else
+    {
+      ::operator delete(p);
+    }
+  }
+
+  /**
+   * The heap nodes have to be deallocated one at a time,
+   * so the nodes are never carved from one contiguous block
+   */
+  T *allocate_contiguous(std::size_t) { return NULL; }
+
+  /**
+   * The heap nodes can only be freed one at a time
+   */
+  bool can_release() const { return false; }
+  void release() {}
+
+  /**
+   * Return the number of inline nodes currently handed out
+   */
+  std::size_t inline_in_use() const
+  {
+    std::size_t count(0);
+    for(uint64_t used = used_; used != 0; used &= used - 1)
+    {
+      ++count;
+    }
+    return count;
+  }
+
+  bool operator==(const InlineAllocator &rhs) const { return this == &rhs; }
+  bool operator!=(const InlineAllocator &rhs) const { return this != &rhs; }
+
+private:
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+  static const uint64_t FULL = (InlineNodes == 64 ? ~uint64_t(0) : (uint64_t(1) << (InlineNodes % 64)) - 1);
+
+  /**
+   * Internal method to find the first free inline node, there must be one
+   */
+  uint32_t firstFree() const
+  {
+#if defined(__GNUC__)
+    return __builtin_ctzll(~used_);
+#else
+    uint32_t slot(0);
+    while(used_ & (uint64_t(1) << slot))
+    {
+      ++slot;
+    }
+    return slot;
+#endif
+  }
+
+  Slot slots_[InlineNodes];
+  uint64_t used_;
+};
+
+/**
+ * True when the copies of an allocator compare equal to it, and copying it
+ * can't throw: a list moved with a copy of its allocator keeps its nodes,
+ * so the move doesn't allocate and can't throw. Other allocators are
+ * assumed not to share their nodes.
+ */
+template <class Allocator>
+struct NodeAllocatorCopiesShareNodes : std::false_type {};
+
+template <class T>
+struct NodeAllocatorCopiesShareNodes<HeapAllocator<T> > : std::true_type {};
+
+template <class T, std::size_t SlabNodes>
+struct NodeAllocatorCopiesShareNodes<PoolAllocator<T, SlabNodes> > : std::true_type {};
+
+#endif /* NODEALLOCATOR_HH_ */
@@ -0,0 +1,233 @@
+/*
+ * ReversibleLinkedList.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef REVERSIBLELINKEDLIST_HH_
+#define REVERSIBLELINKEDLIST_HH_
+
+#include <utility>
+#include <stdint.h>
+
+#include "SimpleLinkedList.hh"
+
+/**
+ * A SimpleLinkedList reversed lazily: reverseIterative() only flips a
+ * direction flag, in O(1), and the operations on the ends of the list,
+ * front(), back(), insert(), append(), pop_front() and pop_back(), are
+ * mapped to the other end while the list is reversed. The nodes are only
+ * relinked, once in O(n), when the order of the nodes matters: iterating
+ * the list, or using any other operation through list(). Reversing twice
+ * before that costs nothing.
+ * It's DoublyLinked by default, so that both ends are O(1). If it's
+ * SinglyLinked, popping the physical tail is O(n), so the nodes are
+ * relinked before, and the pops that follow are O(1).
+ * Like the SimpleLinkedList, it's not thread safe, not even the const
+ * methods, which may relink the nodes.
+ */
+template <class T,
+          class Allocator = HeapAllocator<T>,
+          class LinkPolicy = DoublyLinked,
+          class StatsPolicy = NoStats,
+          class ErrorPolicy = ThrowOnEmpty>
+class ReversibleLinkedList
+{
+public:
+  typedef SimpleLinkedList<T, Allocator, LinkPolicy, StatsPolicy, ErrorPolicy> list_type;
+  typedef typename list_type::iterator iterator;
+  typedef typename list_type::const_iterator const_iterator;
+  typedef typename list_type::node_allocator_type node_allocator_type;
+
+  ReversibleLinkedList() : reversed_(false) {}
+
+  /**
+   * Create a list that allocates its nodes with the given allocator.
+   * Passing the allocator of another list shares its node pool.
+   */
+  explicit ReversibleLinkedList(const node_allocator_type &allocator) : list_(allocator), reversed_(false) {}
+
+  /**
+   * Return an iterator to the beginning of the Linked List, the nodes are relinked if it's reversed.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator begin() { return list().begin(); }
+  const_iterator begin() const { return list().begin(); }
+
+  /**
+   * Return an iterator indicating the end of the Linked List has been reached
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator end() { return list().end(); }
+  const_iterator end() const { return list().end(); }
+
+  /**
+   * Return the underlying list, for the operations that depend on the order
+   * of the nodes. The nodes are relinked first if the list is reversed.
+   */
+  list_type &list()
+  {
+    relink();
+    return list_;
+  }
+  const list_type &list() const
+  {
+    relink();
+    return list_;
+  }
+
+  /**
+   * Return a copy of the allocator used for the list nodes
+   */
+  node_allocator_type get_allocator() const { return list_.get_allocator(); }
+
+  /**
+   * Return the number of elements in the linked list
+   */
+  inline uint32_t size() const { return list_.size(); }
+
+  /**
+   * Return true if the list is empty, false otherwise
+   */
+  inline bool empty() const { return list_.empty(); }
+
+  /**
+   * Return true if the list is reversed, and its nodes not relinked yet
+   */
+  inline bool reversed() const { return reversed_; }
+
+  /**
+   * Insert a data element into the head of the Linked List.
+   */
+  void insert(const T &data) { emplace_front(data); }
+  void insert(T &&data) { emplace_front(std::move(data)); }
+
+  /**
+   * Append a data element onto the end of the Linked List
+   */
+  void append(const T &data) { emplace_back(data); }
+  void append(T &&data) { emplace_back(std::move(data)); }
+
+  template <class... Args>
+  void emplace_front(Args&&... args)
+  {
+    if(reversed_)
+    {
+      list_.emplace_back(std::forward<Args>(args)...);
+    }
+    else
+    {
+      list_.emplace_front(std::forward<Args>(args)...);
+    }
+  }
+
+  template <class... Args>
+  void emplace_back(Args&&... args)
+  {
+    if(reversed_)
+    {
+      list_.emplace_front(std::forward<Args>(args)...);
+    }
+    else
+    {
+      list_.emplace_back(std::forward<Args>(args)...);
+    }
+  }
+
+  /**
+   * Remove the element from the head of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    if(reversed_ && !LinkPolicy::doubly)
+    {
+      relink();
+    }
+
+    if(reversed_)
+    {
+      list_.pop_back();
+    }
+    else
+    {
+      list_.pop_front();
+    }
+  }
+
+  /**
+   * Remove the element from the tail of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   * Algorithmic complexity = O(1) if DoublyLinked or reversed, else O(n)
+   */
+  void pop_back()
+  {
+    if(reversed_)
+    {
+      list_.pop_front();
+    }
+    else
+    {
+      list_.pop_back();
+    }
+  }
+
+  /**
+   * Return the first element in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  inline T &front() { return reversed_ ? list_.back() : list_.front(); }
+  inline const T &front() const { return reversed_ ? list_.back() : list_.front(); }
+
+  /**
+   * Return the last element in the Linked List without modifying the list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  inline T &back() { return reversed_ ? list_.front() : list_.back(); }
+  inline const T &back() const { return reversed_ ? list_.front() : list_.back(); }
+
+  /**
+   * Reverse the order of the elements, the nodes are only relinked when needed
+   * Algorithmic complexity = O(1)
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void reverseIterative()
+  {
+    if(list_.size() < 2)
+    {
+      // Throws if the list is empty, like the SimpleLinkedList
+      list_.reverseIterative();
+      return;
+    }
+    reversed_ = !reversed_;
+  }
+
+  /**
+  * Release the LinkedList resources, emptying the list
+  */
+  void reset()
+  {
+    list_.reset();
+    reversed_ = false;
+  }
+
+  /**
+   * Relink the nodes in the order of the elements if the list is reversed
+   * Algorithmic complexity = O(n) if the list is reversed, else O(1)
+   */
+  void relink() const
+  {
+    if(reversed_)
+    {
+      list_.reverseIterative();
+      reversed_ = false;
+    }
+  }
+
+private:
+  // Relinking the nodes doesn't change the elements, so the const methods can relink them
+  mutable list_type list_;
+  mutable bool reversed_;
+};
+
+#endif /* REVERSIBLELINKEDLIST_HH_ */
@@ -8,23 +8,50 @@
 #ifndef SIMPLELINKEDLIST_HH_
 #define SIMPLELINKEDLIST_HH_
 
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <stdexcept>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <stdint.h>
 
+#include "NodeAllocator.hh"
+#include "ListPolicies.hh"
+#include "ListStats.hh"
+#include "ThreadPool.hh"
+
 /**
  * A simple single LinkedList with minimal functionality
+ * The Allocator is used to allocate the list nodes, the default
+ * HeapAllocator allocates each node individually on the heap.
+ * See NodeAllocator.hh for the allocator requirements.
+ * The LinkPolicy defines how the nodes are linked: SinglyLinked by
+ * default, or DoublyLinked for an O(1) pop_back() and reverse iteration.
+ * See ListPolicies.hh for the policies.
+ * The StatsPolicy collects statistics on the list operations: none with
+ * the default NoStats, at no cost, or CountingStats. See ListStats.hh.
+ * The ErrorPolicy defines what happens on an empty list: ThrowOnEmpty by
+ * default, or NoThrowOnEmpty for unchecked hot paths and -fno-exceptions builds.
  */
-template <class T>
-class SimpleLinkedList
+template <class T,
+          class Allocator = HeapAllocator<T>,
+          class LinkPolicy = SinglyLinked,
+          class StatsPolicy = NoStats,
+          class ErrorPolicy = ThrowOnEmpty>
+class SimpleLinkedList : private StatsPolicy
 {
 private:
   /**
    * Internal class used to store the data in the Linked List
    */
-  struct ListNode
+  struct ListNode : public LinkPolicy::template Links<ListNode>
   {
-    ListNode() : next_(NULL) {}
-    ListNode(const T &data) : data_(data), next_(NULL) {}
+    template <class... Args>
+    ListNode(Args&&... args) : data_(std::forward<Args>(args)...), next_(NULL) {}
     T data_;
     ListNode *next_;
   };
@@ -35,6 +62,12 @@ private:
   class ListIterator
   {
   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T *pointer;
+    typedef T &reference;
+
     ListIterator() : node_(NULL) {}
     ListIterator(ListNode *node) : node_(node) {}
     ListIterator& operator=(ListIterator arg) {node_ = arg.node_; return *this;}
@@ -44,26 +77,73 @@ private:
     T const * operator->() const { return &(node_->data_); }
     T & operator*()  { return node_->data_; }
     T operator*() const { return node_->data_; }
-    void increment()
-    {
-      if(node_->next_ == NULL || node_ == SimpleLinkedList::endSentinel.node_)
-      {
-        node_ = SimpleLinkedList::endSentinel.node_;
-      }
-      else
-      {
-        node_ = node_->next_;
-      }
-    }
-    ListIterator operator++() { ListIterator retval(*this); increment(); return retval; }
-    ListIterator operator++(int unused) {increment(); return *this;}
+    void increment() { node_ = node_->next_; }
+    ListIterator &operator++() { increment(); return *this; }
+    ListIterator operator++(int unused) { ListIterator retval(*this); increment(); return retval; }
+  private:
+    friend class SimpleLinkedList;
+    ListNode *node_;
+  };
+
+  /**
+   * Internal class used to iterate the Linked List from the tail to the head,
+   * only available with the DoublyLinked policy
+   */
+  class ReverseListIterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T *pointer;
+    typedef T &reference;
+
+    ReverseListIterator() : node_(NULL) {}
+    ReverseListIterator(ListNode *node) : node_(node) {}
+    bool operator==(ReverseListIterator rhs) const { return rhs.node_ == node_; }
+    bool operator!=(ReverseListIterator rhs) const { return rhs.node_ != node_; }
+    T * operator->() { return &(node_->data_); }
+    T const * operator->() const { return &(node_->data_); }
+    T & operator*()  { return node_->data_; }
+    const T & operator*() const { return node_->data_; }
+    void increment() { node_ = previousNode(node_, std::integral_constant<bool, LinkPolicy::doubly>()); }
+    ReverseListIterator &operator++() { increment(); return *this; }
+    ReverseListIterator operator++(int unused) { ReverseListIterator retval(*this); increment(); return retval; }
   private:
+    // Templates, so that a SinglyLinked node isn't required to have a prev_ link
+    template <class Node> static Node *previousNode(Node *node, std::true_type) { return node->prev_; }
+    template <class Node> static Node *previousNode(Node *, std::false_type) { return NULL; }
+
     ListNode *node_;
   };
 
 public:
+  typedef T value_type;
   typedef ListIterator iterator;
   typedef ListIterator const_iterator;
+  typedef ReverseListIterator reverse_iterator;
+  typedef ReverseListIterator const_reverse_iterator;
+  typedef typename Allocator::template rebind<ListNode>::other node_allocator_type;
+
+  /**
+   * The maximum number of nodes reverseRecursive() recurses over at a time
+   */
+  static const uint32_t RECURSION_CHUNK = 1024;
+
+  /**
+   * The minimum list size for reverseParallel() to use several threads
+   */
+  static const uint32_t PARALLEL_REVERSE_MIN_SIZE = 1 << 16;
+
+  /**
+   * The minimum list size for sortParallel() to use several threads
+   */
+  static const uint32_t PARALLEL_SORT_MIN_SIZE = 1 << 14;
+
+  /**
+   * The number of nodes compact_for() relocates between two looks at the clock
+   */
+  static const uint32_t COMPACT_CHUNK_SIZE = 1 << 10;
 
   SimpleLinkedList() :
     head_(NULL),
@@ -72,27 +152,157 @@ public:
   {
   }
 
+  /**
+   * Create a list that allocates its nodes with the given allocator.
+   * Passing the allocator of another list shares its node pool.
+   */
+  explicit SimpleLinkedList(const node_allocator_type &allocator) :
+    allocator_(allocator),
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+  }
+
+  /**
+   * Create a list holding the given elements, in order.
+   * The nodes are allocated at once, if the allocator supports it.
+   */
+  SimpleLinkedList(std::initializer_list<T> values) :
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+    assignRange(values.begin(), values.end());
+  }
+
+  SimpleLinkedList(std::initializer_list<T> values, const node_allocator_type &allocator) :
+    allocator_(allocator),
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+    assignRange(values.begin(), values.end());
+  }
+
+  /**
+   * Move the nodes of other into a new list, leaving other empty.
+   * If the copy of the allocator can't take the nodes, like the InlineAllocator,
+   * the elements are moved into new nodes instead. Otherwise it can't throw, so
+   * containers of lists, like std::vector, move them instead of copying them.
+   */
+  SimpleLinkedList(SimpleLinkedList &&other) noexcept(NodeAllocatorCopiesShareNodes<node_allocator_type>::value) :
+    allocator_(other.allocator_),
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+    splice_back(other);
+  }
+
+  /**
+   * Copy the elements of other into a new list, sharing the allocator of other.
+   * The nodes are allocated at once, if the allocator supports it.
+   */
+  SimpleLinkedList(const SimpleLinkedList &other) :
+    allocator_(other.allocator_),
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+    assignRange(ListIterator(other.head_), ListIterator());
+  }
+
+  /**
+   * Release all the nodes, at once if the allocator supports it
+   */
   ~SimpleLinkedList()
   {
+    reset();
+  }
+
+  /**
+   * Replace the elements of this list by copies of the elements of other.
+   * This list keeps its allocator. If an element can't be copied, the list is unchanged.
+   */
+  SimpleLinkedList &operator=(const SimpleLinkedList &other)
+  {
+    if(this == &other)
+    {
+      return *this;
+    }
+
+    SimpleLinkedList copy(allocator_);
+    copy.assignRange(ListIterator(other.head_), ListIterator());
+    reset();
+    splice_back(copy);
+
+    return *this;
   }
 
-  /*
-   * Applying the "Rule of 3": since the dtor is not implemented, no need to impl the copy ctor nor assign operator
+  /**
+   * Release the nodes of this list and move the nodes of other into it, leaving other empty.
+   * If the allocator can't take the nodes of other, the elements are moved into new nodes.
+   * Otherwise it can't throw.
    */
+  SimpleLinkedList &operator=(SimpleLinkedList &&other) noexcept(NodeAllocatorCopiesShareNodes<node_allocator_type>::value)
+  {
+    if(this == &other)
+    {
+      return *this;
+    }
+
+    reset();
+    allocator_ = other.allocator_;
+    splice_back(other);
+
+    return *this;
+  }
 
   /**
    * Return an iterator to the beginning of the Linked List.
-   * If the list is empty, an std::length_error exception will be thrown.
+   * If the list is empty, an std::length_error exception will be thrown,
+   * or with the NoThrowOnEmpty policy, begin() == end().
    */
   SimpleLinkedList::iterator begin() { emptyException(); return ListIterator(head_); }
   SimpleLinkedList::const_iterator begin() const { emptyException(); return ListIterator(head_); }
 
   /**
-   * Return an iterator indicating the end of the Linked List has been reached
+   * Return an iterator indicating the end of the Linked List has been reached,
+   * it's past the tail node, whose next_ link is NULL.
    * If the list is empty, an std::length_error exception will be thrown.
    */
-  SimpleLinkedList::iterator end() { emptyException(); return endSentinel; }
-  SimpleLinkedList::const_iterator end() const { emptyException(); return endSentinel; }
+  SimpleLinkedList::iterator end() { emptyException(); return ListIterator(); }
+  SimpleLinkedList::const_iterator end() const { emptyException(); return ListIterator(); }
+
+  /**
+   * Return an iterator to the tail of the Linked List, to iterate it in reverse.
+   * Only available with the DoublyLinked policy.
+   * If the list is empty, rbegin() == rend().
+   */
+  template <class Policy = LinkPolicy>
+  typename std::enable_if<Policy::doubly, reverse_iterator>::type rbegin() { return ReverseListIterator(tail_); }
+  template <class Policy = LinkPolicy>
+  typename std::enable_if<Policy::doubly, const_reverse_iterator>::type rbegin() const { return ReverseListIterator(tail_); }
+
+  /**
+   * Return a reverse iterator indicating the head of the Linked List has been passed
+   * Only available with the DoublyLinked policy.
+   */
+  template <class Policy = LinkPolicy>
+  typename std::enable_if<Policy::doubly, reverse_iterator>::type rend() { return ReverseListIterator(); }
+  template <class Policy = LinkPolicy>
+  typename std::enable_if<Policy::doubly, const_reverse_iterator>::type rend() const { return ReverseListIterator(); }
+
+  /**
+   * Return a copy of the allocator used for the list nodes
+   */
+  node_allocator_type get_allocator() const { return allocator_; }
+
+  /**
+   * Return the stats policy, to get the statistics it collected
+   */
+  const StatsPolicy &stats() const { return *this; }
 
   /**
    * Return the number of elements in the linked list
@@ -107,27 +317,47 @@ public:
   /**
    * Insert a data node into the head of the Linked List
    */
-  void insert(T data)
-  {
+  void insert(const T &data) { emplace_front(data); }
+  void insert(T &&data) { emplace_front(std::move(data)); }
 
+  /**
+   * Append a data node onto the end of the Linked List
+   */
+  void append(const T &data) { emplace_back(data); }
+  void append(T &&data) { emplace_back(std::move(data)); }
+
+  /**
+   * Insert a data node into the head of the Linked List,
+   * constructing the data in place with the given arguments
+   */
+  template <class... Args>
+  void emplace_front(Args&&... args)
+  {
+    StatsScope scope(*this, LIST_OP_INSERT);
+    ListNode *newNode(createNode(std::forward<Args>(args)...));
     if(empty())
     {
-      append(data);
-      return;
+      head_ = newNode;
+      tail_ = newNode;
+    }
+    else
+    {
+      newNode->next_ = head_;
+      head_->setPrev(newNode);
+      head_ = newNode;
     }
-
-    ListNode *newNode(new ListNode(data));
-    newNode->next_ = head_;
-    head_ = newNode;
     ++size_;
   }
 
   /**
-   * Append a data node onto the end of the Linked List
+   * Append a data node onto the end of the Linked List,
+   * constructing the data in place with the given arguments
    */
-  void append(T data)
+  template <class... Args>
+  void emplace_back(Args&&... args)
   {
-    ListNode *newNode(new ListNode(data));
+    StatsScope scope(*this, LIST_OP_APPEND);
+    ListNode *newNode(createNode(std::forward<Args>(args)...));
     if(empty())
     {
       head_ = newNode;
@@ -136,39 +366,118 @@ public:
     else
     {
       tail_->next_ = newNode;
+      newNode->setPrev(tail_);
       tail_ = newNode;
     }
     size_++;
   }
 
+  /**
+   * Append copies of the elements in [first, last) onto the end of the Linked List.
+   * The nodes are allocated in one contiguous block if the allocator supports it,
+   * and linked in a single pass. If an element can't be copied, the list is unchanged.
+   */
+  template <class ForwardIterator>
+  void append_range(ForwardIterator first, ForwardIterator last)
+  {
+    StatsScope scope(*this, LIST_OP_RANGE);
+    SimpleLinkedList range(allocator_);
+    range.assignRange(first, last);
+    if(range.allocator_ == allocator_)
+    {
+      // Otherwise the elements are moved into new nodes, counted when they're allocated
+      statsPolicy().nodesAllocated(range.size_);
+    }
+    splice_back(range);
+  }
+
+  /**
+   * Insert copies of the elements in [first, last), in order, into the head of the Linked List.
+   * The nodes are allocated in one contiguous block if the allocator supports it,
+   * and linked in a single pass. If an element can't be copied, the list is unchanged.
+   */
+  template <class ForwardIterator>
+  void insert_range(ForwardIterator first, ForwardIterator last)
+  {
+    StatsScope scope(*this, LIST_OP_RANGE);
+    SimpleLinkedList range(allocator_);
+    range.assignRange(first, last);
+    if(range.allocator_ == allocator_)
+    {
+      statsPolicy().nodesAllocated(range.size_);
+    }
+    splice_front(range);
+  }
+
   /**
    * Remove the node from the head of the Linked list
    * If the list is empty, an std::length_error exception will be thrown.
    */
   void pop_front()
   {
+      StatsScope scope(*this, LIST_OP_POP_FRONT);
       emptyException();
 
       if(size() == 1)
       {
-        delete head_;
+        destroyNode(head_);
         head_ = tail_ = NULL;
         size_ = 0;
         return;
       }
 
       ListNode *node(head_->next_);
-      delete head_;
+      destroyNode(head_);
       head_ = node;
+      head_->setPrev(NULL);
       size_--;
   }
 
+  /**
+   * Move the first element into data and remove it from the Linked List.
+   * Return false, leaving data untouched, if the list is empty.
+   * This never throws on an empty list, whatever the ErrorPolicy.
+   */
+  bool try_pop_front(T &data)
+  {
+    if(empty())
+    {
+      return false;
+    }
+
+    StatsScope scope(*this, LIST_OP_POP_FRONT);
+    data = std::move(head_->data_);
+    pop_front();
+    return true;
+  }
+
+  /**
+   * Move the last element into data and remove it from the Linked List.
+   * Return false, leaving data untouched, if the list is empty.
+   * This never throws on an empty list, whatever the ErrorPolicy.
+   * Algorithmic complexity = O(n) with the SinglyLinked policy, O(1) with DoublyLinked
+   */
+  bool try_pop_back(T &data)
+  {
+    if(empty())
+    {
+      return false;
+    }
+
+    StatsScope scope(*this, LIST_OP_POP_BACK);
+    data = std::move(tail_->data_);
+    pop_back();
+    return true;
+  }
+
   /**
    * Remove the node from the tail of the Linked list
    * If the list is empty, an std::length_error exception will be thrown.
+   * Algorithmic complexity = O(n) with the SinglyLinked policy, O(1) with DoublyLinked
    */
   void pop_back()
   {
+      StatsScope scope(*this, LIST_OP_POP_BACK);
       emptyException();
 
       if(size() == 1)
@@ -177,138 +486,1032 @@ public:
         return;
       }
 
-      // Iterate to the penultimate node
-      ListNode *node(head_);
-      while(node->next_ != tail_)
-      {
-        node = node->next_;
-      }
-      delete tail_;
+      statsPolicy().popBackWalked(LinkPolicy::doubly ? 0 : size_ - 2);
+      // Find the penultimate node, iterating to it unless the nodes are doubly linked
+      ListNode *node(LinkPolicy::previous(head_, tail_));
+      destroyNode(tail_);
       tail_ = node;
+      tail_->next_ = NULL;
       size_--;
   }
 
-  /* For a more complex version, the following two should be implemented
-  void insert(iterator iter, T data);
-  void remove(iterator iter);
-  */
-
   /**
-  * Release the LinkedList resources, emptying the list
-  */
-  void reset()
+   * Move all the nodes of other onto the end of this Linked List, leaving other empty.
+   * Algorithmic complexity = O(1) when both lists use the same allocator (always
+   * the case with the HeapAllocator), otherwise the elements are moved one by one.
+   */
+  void splice_back(SimpleLinkedList &other)
   {
-    // remove all the nodes
-    while(!empty())
+    StatsScope scope(*this, LIST_OP_SPLICE);
+    if(other.empty() || this == &other)
+    {
+      return;
+    }
+
+    if(allocator_ != other.allocator_)
+    {
+      for(ListNode *node = other.head_; node != NULL; node = node->next_)
+      {
+        emplace_back(std::move(node->data_));
+      }
+      other.reset();
+      return;
+    }
+
+    if(empty())
     {
-      pop_front();
+      head_ = other.head_;
     }
+    else
+    {
+      tail_->next_ = other.head_;
+      other.head_->setPrev(tail_);
+    }
+    tail_ = other.tail_;
+    size_ += other.size_;
+    other.head_ = other.tail_ = NULL;
+    other.size_ = 0;
   }
 
   /**
-   * Return the first node in the Linked List without modifying the list.
-   * If the list is empty, an std::length_error exception will be thrown.
+   * Move all the nodes of other onto the head of this Linked List, leaving other empty.
+   * Algorithmic complexity = O(1) when both lists use the same allocator (always
+   * the case with the HeapAllocator), otherwise the elements are moved one by one.
    */
-  inline T front() { emptyException(); return head_->data_; }
+  void splice_front(SimpleLinkedList &other)
+  {
+    StatsScope scope(*this, LIST_OP_SPLICE);
+    if(other.empty() || this == &other)
+    {
+      return;
+    }
 
-  /**
-   * Return the last node in the Linked List without modifying the list
-   * If the list is empty, an std::length_error exception will be thrown.
-   */
-  inline T back() { emptyException(); return tail_->data_; }
+    if(allocator_ != other.allocator_)
+    {
+      // Move the elements into new nodes, each inserted after the previous one
+      ListNode *node(other.head_);
+      emplace_front(std::move(node->data_));
+      ListIterator pos(head_);
+      for(node = node->next_; node != NULL; node = node->next_)
+      {
+        pos = emplace_after(pos, std::move(node->data_));
+      }
+      other.reset();
+      return;
+    }
+
+    if(empty())
+    {
+      swapNodes(other);
+      return;
+    }
+
+    other.tail_->next_ = head_;
+    head_->setPrev(other.tail_);
+    head_ = other.head_;
+    size_ += other.size_;
+    other.head_ = other.tail_ = NULL;
+    other.size_ = 0;
+  }
 
   /**
-   * Reverse the order of all the Nodes in the Linked List iteratively
-   * Algorithmic complexity = O(n), No extra memory is used
-   * If the list is empty, an std::length_error exception will be thrown.
+   * Split the Linked List after its first n nodes: the following nodes are
+   * returned in a new list, which shares the allocator of this list.
+   * If n >= size(), the returned list is empty.
+   * Algorithmic complexity = O(n), the nodes are not copied, unless the
+   * allocator can't be shared, then the elements are moved into new nodes
    */
-  void reverseIterative()
+  SimpleLinkedList split_at(uint32_t n)
   {
-    emptyException();
-    if(size() == 1)
+    StatsScope scope(*this, LIST_OP_SPLIT);
+    SimpleLinkedList suffix(allocator_);
+    if(n >= size_)
     {
-      // nothing to be done
-      return;
+      return suffix;
     }
 
-    tail_ = head_;
-    ListNode *newHead(head_);
+    if(n == 0)
+    {
+      suffix.splice_back(*this);
+      return suffix;
+    }
 
-    while(head_ != NULL)
+    ListNode *last(head_);
+    for(uint32_t i = 1; i < n; ++i)
     {
-      ListNode *node = head_;
-      head_ = node->next_;
-      node->next_ = newHead;
-      newHead = node;
+      last = last->next_;
     }
+    cutAfter(last, size_ - n, suffix);
 
-    head_ = newHead;
-    tail_->next_ = NULL;
+    return suffix;
   }
 
   /**
-   * Reverse the order of all the Nodes in the Linked List recursively.
-   * Algorithmic complexity = O(n), The only memory used is the stack needed to recurse.
-   * If the list is empty, an std::length_error exception will be thrown.
+   * Split the Linked List after the node at iter: the following nodes are
+   * returned in a new list, which shares the allocator of this list.
+   * If iter is at the tail, or is end(), the returned list is empty.
+   * Algorithmic complexity = O(number of nodes returned), to count them.
    */
-  void reverseRecursive()
+  SimpleLinkedList split_after(iterator iter)
   {
-    emptyException();
-    if(size() == 1)
+    StatsScope scope(*this, LIST_OP_SPLIT);
+    SimpleLinkedList suffix(allocator_);
+    ListNode *last(iter.node_);
+    if(last == NULL || last == tail_)
     {
-      // nothing to be done
-      return;
+      return suffix;
     }
 
-    ListNode *node = head_;
-    ListNode *newHead;
-    ListNode *newTail;
-    reverseRecursiveInternal(node, newHead, newTail);
-    head_ = newHead;
-    tail_ = newTail;
+    uint32_t count(0);
+    for(ListNode *node = last->next_; node != NULL; node = node->next_)
+    {
+      ++count;
+    }
+    cutAfter(last, count, suffix);
+
+    return suffix;
   }
 
-private:
+  /**
+   * Insert a data node after the node at pos, which must not be end(),
+   * and return an iterator to the new node.
+   * Algorithmic complexity = O(1)
+   */
+  iterator insert_after(iterator pos, const T &data) { return emplace_after(pos, data); }
+  iterator insert_after(iterator pos, T &&data) { return emplace_after(pos, std::move(data)); }
 
   /**
-   * Internal method that actually performs the recursion to reverse the list
+   * Insert a data node after the node at pos, which must not be end(),
+   * constructing the data in place with the given arguments.
+   * Return an iterator to the new node.
    */
-  void reverseRecursiveInternal(ListNode *node, ListNode *&head, ListNode *&tail)
+  template <class... Args>
+  iterator emplace_after(iterator pos, Args&&... args)
   {
-    // recursion exit condition
-    if(node->next_ == NULL)
+    StatsScope scope(*this, LIST_OP_INSERT_AFTER);
+    ListNode *node(pos.node_);
+    if(node == NULL)
     {
-      head = node;
-      tail = node;
-      return;
+      LIST_THROW(std::out_of_range("can't insert after end()"));
     }
 
-    reverseRecursiveInternal(node->next_, head, tail);
+    ListNode *newNode(createNode(std::forward<Args>(args)...));
+    newNode->next_ = node->next_;
+    newNode->setPrev(node);
+    if(node == tail_)
+    {
+      tail_ = newNode;
+    }
+    else
+    {
+      node->next_->setPrev(newNode);
+    }
+    node->next_ = newNode;
+    ++size_;
 
-    tail->next_ = node;
-    tail = node;
-    node->next_ = NULL;
+    return ListIterator(newNode);
   }
 
   /**
-   * Internal method to check if the Linked List is empty.
-   * Throws a std::length_error exception if it is empty
+   * Remove the node following the node at pos, and return an iterator to the
+   * node that followed the removed one, or end().
+   * If there's no node after pos, an std::out_of_range exception will be thrown.
+   * Algorithmic complexity = O(1)
    */
-  void emptyException() const
+  iterator erase_after(iterator pos)
   {
-    if(empty())
+    StatsScope scope(*this, LIST_OP_ERASE);
+    ListNode *node(pos.node_);
+    if(node == NULL || node->next_ == NULL)
     {
-      throw std::length_error("the list is empty");
+      LIST_THROW(std::out_of_range("no node to erase after the iterator"));
     }
-  }
 
-  static ListIterator endSentinel;
-  ListNode *head_;
-  ListNode *tail_;
-  uint32_t size_;
-};
+    ListNode *erased(node->next_);
+    node->next_ = erased->next_;
+    if(erased == tail_)
+    {
+      tail_ = node;
+    }
+    else
+    {
+      erased->next_->setPrev(node);
+    }
+    destroyNode(erased);
+    --size_;
+
+    return ListIterator(node->next_);
+  }
+
+  /**
+   * Remove all the nodes whose data satisfies pred, in a single pass over the list.
+   * Return the number of nodes removed.
+   * Algorithmic complexity = O(n)
+   */
+  template <class Predicate>
+  uint32_t remove_if(Predicate pred)
+  {
+    StatsScope scope(*this, LIST_OP_ERASE);
+    uint32_t removed(0);
+    ListNode *prev(NULL);
+    ListNode *node(head_);
+    while(node != NULL)
+    {
+      ListNode *next(node->next_);
+      if(pred(node->data_))
+      {
+        if(prev == NULL)
+        {
+          head_ = next;
+        }
+        else
+        {
+          prev->next_ = next;
+        }
+        if(next != NULL)
+        {
+          next->setPrev(prev);
+        }
+        destroyNode(node);
+        --size_;
+        ++removed;
+      }
+      else
+      {
+        prev = node;
+      }
+      node = next;
+    }
+    // Only updated once the whole list was visited, so the tail is right if pred throws
+    tail_ = prev;
+
+    return removed;
+  }
+
+  /**
+   * Remove all the nodes whose data equals value, in a single pass over the list.
+   * Return the number of nodes removed.
+   */
+  uint32_t remove(const T &value)
+  {
+    return remove_if([&value](const T &data) { return data == value; });
+  }
+
+  /**
+  * Release the LinkedList resources, emptying the list
+  * If the allocator supports it, all the nodes are freed at once,
+  * instead of walking the list to free them one by one.
+  */
+  void reset()
+  {
+    StatsScope scope(*this, LIST_OP_RESET);
+    if(!empty() && allocator_.can_release())
+    {
+      // Only walk the list if there are destructors to call
+      if(!std::is_trivially_destructible<T>::value)
+      {
+        ListNode *node(head_);
+        while(node != NULL)
+        {
+          ListNode *next(node->next_);
+          node->~ListNode();
+          node = next;
+        }
+      }
+      allocator_.release();
+      statsPolicy().nodesFreed(size_);
+      head_ = tail_ = NULL;
+      size_ = 0;
+      return;
+    }
+
+    // free all the nodes, without relinking the list after each one
+    ListNode *node(head_);
+    while(node != NULL)
+    {
+      ListNode *next(node->next_);
+      destroyNode(node);
+      node = next;
+    }
+    head_ = tail_ = NULL;
+    size_ = 0;
+  }
+
+  /**
+   * Return the first node in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  inline T &front() { emptyException(); return head_->data_; }
+  inline const T &front() const { emptyException(); return head_->data_; }
+
+  /**
+   * Return the last node in the Linked List without modifying the list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  inline T &back() { emptyException(); return tail_->data_; }
+  inline const T &back() const { emptyException(); return tail_->data_; }
+
+  /**
+   * Return a pointer to the first or last element, or NULL if the list is empty.
+   * These never throw, whatever the ErrorPolicy.
+   */
+  inline T *front_ptr() { return empty() ? NULL : &head_->data_; }
+  inline const T *front_ptr() const { return empty() ? NULL : &head_->data_; }
+  inline T *back_ptr() { return empty() ? NULL : &tail_->data_; }
+  inline const T *back_ptr() const { return empty() ? NULL : &tail_->data_; }
+
+  /**
+   * Reverse the order of all the Nodes in the Linked List iteratively
+   * Algorithmic complexity = O(n), No extra memory is used
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void reverseIterative()
+  {
+    StatsScope scope(*this, LIST_OP_REVERSE);
+    emptyException();
+    if(size() < 2)
+    {
+      // nothing to be done
+      return;
+    }
+
+    tail_ = head_;
+    ListNode *newHead(head_);
+
+    while(head_ != NULL)
+    {
+      ListNode *node = head_;
+      head_ = node->next_;
+      node->next_ = newHead;
+      node->setPrev(head_);
+      newHead = node;
+    }
+
+    head_ = newHead;
+    tail_->next_ = NULL;
+  }
+
+  /**
+   * Reverse the order of all the Nodes in the Linked List recursively.
+   * The list is cut into segments of at most RECURSION_CHUNK nodes, each segment is
+   * reversed recursively and stitched in front of the segments already reversed,
+   * so the recursion depth is bounded whatever the size of the list.
+   * Algorithmic complexity = O(n), The only memory used is the stack needed to recurse.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void reverseRecursive()
+  {
+    StatsScope scope(*this, LIST_OP_REVERSE);
+    emptyException();
+    if(size() < 2)
+    {
+      // nothing to be done
+      return;
+    }
+
+    ListNode *newHead(NULL);
+    ListNode *newTail(NULL);
+    ListNode *node(head_);
+    while(node != NULL)
+    {
+      ListNode *last(node);
+      for(uint32_t i = 1; i < RECURSION_CHUNK && last->next_ != NULL; ++i)
+      {
+        last = last->next_;
+      }
+      ListNode *next(last->next_);
+      last->next_ = NULL;
+
+      ListNode *segmentHead;
+      ListNode *segmentTail;
+      reverseRecursiveInternal(node, segmentHead, segmentTail);
+      prependSegment(segmentHead, segmentTail, newHead, newTail);
+      node = next;
+    }
+
+    head_ = newHead;
+    tail_ = newTail;
+  }
+
+  /**
+   * Reverse the order of all the Nodes in the Linked List, using the pool threads.
+   * The list is cut into one segment per pool thread, the segments are reversed
+   * in parallel, then stitched back together in reverse order. Lists smaller than
+   * PARALLEL_REVERSE_MIN_SIZE are reversed iteratively by the calling thread.
+   * Algorithmic complexity = O(n), with one extra pass to find the segments.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void reverseParallel(ThreadPool &pool = ThreadPool::instance())
+  {
+    StatsScope scope(*this, LIST_OP_REVERSE);
+    emptyException();
+    uint32_t numSegments(pool.size());
+    if(numSegments < 2 || size() < PARALLEL_REVERSE_MIN_SIZE)
+    {
+      reverseIterative();
+      return;
+    }
+
+    // Find the first node of each segment, the last segment takes the remainder
+    uint32_t segmentSize(size_ / numSegments);
+    std::vector<ListNode*> firsts(numSegments);
+    ListNode *node(head_);
+    for(uint32_t i = 0; i < numSegments; ++i)
+    {
+      firsts[i] = node;
+      for(uint32_t j = 0; j < segmentSize && i + 1 < numSegments; ++j)
+      {
+        node = node->next_;
+      }
+    }
+
+    std::vector<ListNode*> heads(numSegments);
+    std::vector<ListNode*> tails(numSegments);
+    uint32_t lastSegmentSize(size_ - segmentSize * (numSegments - 1));
+    pool.run(numSegments, [&](size_t i) {
+      reverseSegment(firsts[i], (i + 1 < numSegments ? segmentSize : lastSegmentSize), heads[i], tails[i]);
+    });
+
+    ListNode *newHead(NULL);
+    ListNode *newTail(NULL);
+    for(uint32_t i = 0; i < numSegments; ++i)
+    {
+      prependSegment(heads[i], tails[i], newHead, newTail);
+    }
+
+    head_ = newHead;
+    tail_ = newTail;
+  }
+
+  /**
+   * Sort the Linked List in place, in ascending order, or in the order defined by comp.
+   * The sort is a stable bottom-up merge sort that only relinks the nodes,
+   * the elements are neither copied nor moved.
+   * Algorithmic complexity = O(n log n), No extra memory is used
+   */
+  void sort() { sort(std::less<T>()); }
+
+  template <class Compare>
+  void sort(Compare comp)
+  {
+    StatsScope scope(*this, LIST_OP_SORT);
+    if(size() < 2)
+    {
+      return;
+    }
+
+    sortRun(head_, comp, head_, tail_);
+    relinkPrev();
+  }
+
+  /**
+   * Sort the Linked List in place like sort(), using the pool threads.
+   * The list is cut into one sublist per pool thread, the sublists are sorted
+   * in parallel, then merged pairwise, each level of merges in parallel.
+   * Lists smaller than PARALLEL_SORT_MIN_SIZE are sorted by the calling thread.
+   * comp may be called concurrently from several threads.
+   */
+  void sortParallel(ThreadPool &pool = ThreadPool::instance()) { sortParallel(std::less<T>(), pool); }
+
+  template <class Compare>
+  void sortParallel(Compare comp, ThreadPool &pool = ThreadPool::instance())
+  {
+    StatsScope scope(*this, LIST_OP_SORT);
+    uint32_t numRuns(pool.size());
+    if(numRuns < 2 || size() < PARALLEL_SORT_MIN_SIZE)
+    {
+      sort(comp);
+      return;
+    }
+
+    // Cut the list into numRuns sublists, the last one takes the remainder
+    uint32_t runSize(size_ / numRuns);
+    std::vector<ListNode*> heads(numRuns);
+    std::vector<ListNode*> tails(numRuns);
+    ListNode *node(head_);
+    for(uint32_t i = 0; i < numRuns; ++i)
+    {
+      heads[i] = node;
+      if(i + 1 < numRuns)
+      {
+        for(uint32_t j = 1; j < runSize; ++j)
+        {
+          node = node->next_;
+        }
+        ListNode *next(node->next_);
+        node->next_ = NULL;
+        node = next;
+      }
+    }
+
+    pool.run(numRuns, [&](size_t i) {
+      Compare runComp(comp);
+      sortRun(heads[i], runComp, heads[i], tails[i]);
+    });
+
+    // Merge neighbouring runs, keeping the earlier run on the left for stability
+    for(uint32_t step = 1; step < numRuns; step *= 2)
+    {
+      pool.run((numRuns + 2 * step - 1) / (2 * step), [&](size_t pair) {
+        uint32_t left(pair * 2 * step);
+        uint32_t right(left + step);
+        if(right < numRuns)
+        {
+          Compare runComp(comp);
+          mergeRuns(heads[left], tails[left], heads[right], tails[right], runComp);
+        }
+      });
+    }
+
+    head_ = heads[0];
+    tail_ = tails[0];
+    relinkPrev();
+  }
+
+  /**
+   * Relocate all the nodes into new nodes allocated in list order, so that
+   * iterating the list walks forward through memory. The nodes are carved
+   * from one contiguous block if the allocator can provide it, like with the
+   * PoolAllocator, else they're allocated one at a time before the old ones
+   * are freed. The data is moved, or copied if its move may throw, in which
+   * case the list is left unchanged. All the iterators are invalidated.
+   * Algorithmic complexity = O(n), the list temporarily uses twice the memory
+   */
+  void compact()
+  {
+    StatsScope scope(*this, LIST_OP_COMPACT);
+    if(!empty())
+    {
+      relocateRun(NULL, size_);
+    }
+  }
+
+  /**
+   * Like compact(), but incrementally: relocate the nodes following position,
+   * or from the head if position is end(), in chunks of COMPACT_CHUNK_SIZE
+   * nodes until the list end or until budget is spent. position is then set
+   * to the last node relocated, to resume from on the next call, and true is
+   * returned once the list end was reached. The list may be modified between
+   * calls as long as the node at position isn't removed.
+   * Only the allocators providing contiguous blocks keep the chunks together:
+   * others, like the HeapAllocator, can reuse the freed nodes for the next
+   * chunks, use compact() with them.
+   * Algorithmic complexity = O(1) per node
+   */
+  bool compact_for(std::chrono::nanoseconds budget, iterator &position)
+  {
+    StatsScope scope(*this, LIST_OP_COMPACT);
+    std::chrono::steady_clock::time_point deadline(std::chrono::steady_clock::now() + budget);
+    ListNode *before(position.node_);
+    for(;;)
+    {
+      uint32_t count(0);
+      for(ListNode *node = (before == NULL ? head_ : before->next_);
+          node != NULL && count < COMPACT_CHUNK_SIZE;
+          node = node->next_)
+      {
+        ++count;
+      }
+      if(count == 0)
+      {
+        return true;
+      }
+
+      before = relocateRun(before, count);
+      position = ListIterator(before);
+      if(std::chrono::steady_clock::now() >= deadline)
+      {
+        return before == tail_;
+      }
+    }
+  }
+
+private:
+
+  /**
+   * Internal method to move the count nodes following last into the empty list suffix.
+   * If suffix can't take the nodes, the elements are moved into new nodes of suffix.
+   */
+  void cutAfter(ListNode *last, uint32_t count, SimpleLinkedList &suffix)
+  {
+    if(suffix.allocator_ != allocator_)
+    {
+      ListNode *node(last->next_);
+      while(node != NULL)
+      {
+        ListNode *next(node->next_);
+        suffix.emplace_back(std::move(node->data_));
+        destroyNode(node);
+        node = next;
+      }
+      last->next_ = NULL;
+      tail_ = last;
+      size_ -= count;
+      return;
+    }
+
+    suffix.head_ = last->next_;
+    suffix.head_->setPrev(NULL);
+    suffix.tail_ = tail_;
+    suffix.size_ = count;
+
+    last->next_ = NULL;
+    tail_ = last;
+    size_ -= count;
+  }
+
+  /**
+   * Internal method to exchange the nodes, but not the allocators, of two lists
+   */
+  void swapNodes(SimpleLinkedList &other)
+  {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+  }
+
+  /**
+   * Internal method to allocate and construct a node with the allocator
+   */
+  template <class... Args>
+  ListNode *createNode(Args&&... args)
+  {
+    ListNode *node(allocator_.allocate());
+    LIST_TRY
+    {
+      new (node) ListNode(std::forward<Args>(args)...);
+    }
+    LIST_CATCH_ALL
+    {
+      allocator_.deallocate(node);
+      LIST_RETHROW;
+    }
+    statsPolicy().nodesAllocated(1);
+
+    return node;
+  }
+
+  /**
+   * Internal method to relocate the count nodes following before, or from the head if
+   * before is NULL, into new nodes allocated in order. Return the last new node.
+   * If constructing a new node throws, the new nodes are freed and the list is unchanged.
+   */
+  ListNode *relocateRun(ListNode *before, uint32_t count)
+  {
+    ListNode *first(before == NULL ? head_ : before->next_);
+    std::vector<ListNode*> nodes(count);
+    ListNode *block(allocator_.allocate_contiguous(count));
+    uint32_t built(0);
+    LIST_TRY
+    {
+      for(ListNode *node = first; built < count; node = node->next_, ++built)
+      {
+        ListNode *newNode(block == NULL ? allocator_.allocate() : block + built);
+        LIST_TRY
+        {
+          new (newNode) ListNode(std::move_if_noexcept(node->data_));
+        }
+        LIST_CATCH_ALL
+        {
+          if(block == NULL)
+          {
+            allocator_.deallocate(newNode);
+          }
+          LIST_RETHROW;
+        }
+        nodes[built] = newNode;
+      }
+    }
+    LIST_CATCH_ALL
+    {
+      // Only copies may throw, so the old nodes are intact
+      for(uint32_t i = 0; i < count; ++i)
+      {
+        if(i < built)
+        {
+          nodes[i]->~ListNode();
+        }
+        if(i < built || block != NULL)
+        {
+          allocator_.deallocate(block == NULL ? nodes[i] : block + i);
+        }
+      }
+      LIST_RETHROW;
+    }
+    statsPolicy().nodesAllocated(count);
+
+    // Link the new nodes in place of the old ones, then free the old ones
+    ListNode *after(first);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+      ListNode *old(after);
+      after = after->next_;
+      nodes[i]->setPrev(i == 0 ? before : nodes[i - 1]);
+      nodes[i]->next_ = (i + 1 < count ? nodes[i + 1] : after);
+      destroyNode(old);
+    }
+
+    if(before == NULL)
+    {
+      head_ = nodes[0];
+    }
+    else
+    {
+      before->next_ = nodes[0];
+    }
+    if(after == NULL)
+    {
+      tail_ = nodes[count - 1];
+    }
+    else
+    {
+      after->setPrev(nodes[count - 1]);
+    }
+
+    return nodes[count - 1];
+  }
+
+  /**
+   * Internal method to fill the empty list with copies of the elements in [first, last),
+   * constructed in one contiguous block of nodes if the allocator can provide it.
+   * If a copy throws, the unused nodes of the block are deallocated and the list emptied.
+   */
+  template <class ForwardIterator>
+  void assignRange(ForwardIterator first, ForwardIterator last)
+  {
+    std::size_t count(std::distance(first, last));
+    if(count == 0)
+    {
+      return;
+    }
+
+    ListNode *block(allocator_.allocate_contiguous(count));
+    if(block != NULL)
+    {
+      statsPolicy().nodesAllocated(count);
+    }
+    std::size_t built(0);
+    LIST_TRY
+    {
+      for(; first != last; ++first, ++built)
+      {
+        ListNode *node;
+        if(block != NULL)
+        {
+          node = block + built;
+          new (node) ListNode(*first);
+        }
+        else
+        {
+          node = createNode(*first);
+        }
+
+        node->setPrev(tail_);
+        if(tail_ == NULL)
+        {
+          head_ = node;
+        }
+        else
+        {
+          tail_->next_ = node;
+        }
+        tail_ = node;
+        ++size_;
+      }
+    }
+    LIST_CATCH_ALL
+    {
+      // The unused nodes first, reset() may release the whole pool
+      if(block != NULL)
+      {
+        for(std::size_t i = built; i < count; ++i)
+        {
+          allocator_.deallocate(block + i);
+        }
+        statsPolicy().nodesFreed(count - built);
+      }
+      reset();
+      LIST_RETHROW;
+    }
+  }
+
+  /**
+   * Internal method to destroy and deallocate a node with the allocator
+   */
+  void destroyNode(ListNode *node)
+  {
+    node->~ListNode();
+    allocator_.deallocate(node);
+    statsPolicy().nodesFreed(1);
+  }
+
+  /**
+   * Internal method to merge the sorted run rightHead..rightTail into the sorted run
+   * leftHead..leftTail. On equal elements, those of the left run come first.
+   */
+  template <class Compare>
+  static void mergeRuns(ListNode *&leftHead, ListNode *&leftTail,
+                        ListNode *rightHead, ListNode *rightTail, Compare &comp)
+  {
+    ListNode *head(NULL);
+    ListNode **link(&head);
+    ListNode *left(leftHead);
+    ListNode *right(rightHead);
+    while(left != NULL && right != NULL)
+    {
+      if(comp(right->data_, left->data_))
+      {
+        *link = right;
+        right = right->next_;
+      }
+      else
+      {
+        *link = left;
+        left = left->next_;
+      }
+      link = &((*link)->next_);
+    }
+
+    if(left != NULL)
+    {
+      *link = left;
+    }
+    else
+    {
+      *link = right;
+      leftTail = rightTail;
+    }
+    leftHead = head;
+  }
 
-template <class T>
-typename SimpleLinkedList<T>::ListIterator SimpleLinkedList<T>::endSentinel = SimpleLinkedList<T>::ListIterator(new ListNode());
+  /**
+   * Internal method to sort the NULL terminated chain of nodes starting at first.
+   * Bottom-up: runs[i] holds either nothing or a sorted run of 2^i nodes, and each
+   * node is added like a carry, merging the runs of the same size.
+   */
+  template <class Compare>
+  static void sortRun(ListNode *first, Compare &comp, ListNode *&head, ListNode *&tail)
+  {
+    ListNode *runHeads[32] = {NULL};
+    ListNode *runTails[32];
+    ListNode *node(first);
+    while(node != NULL)
+    {
+      ListNode *runHead(node);
+      ListNode *runTail(node);
+      node = node->next_;
+      runTail->next_ = NULL;
+
+      uint32_t i(0);
+      for(; runHeads[i] != NULL; ++i)
+      {
+        // runs[i] holds earlier elements, so it's the left run
+        mergeRuns(runHeads[i], runTails[i], runHead, runTail, comp);
+        runHead = runHeads[i];
+        runTail = runTails[i];
+        runHeads[i] = NULL;
+      }
+      runHeads[i] = runHead;
+      runTails[i] = runTail;
+    }
+
+    head = NULL;
+    for(uint32_t i = 0; i < 32; ++i)
+    {
+      if(runHeads[i] == NULL)
+      {
+        continue;
+      }
+      if(head == NULL)
+      {
+        head = runHeads[i];
+        tail = runTails[i];
+      }
+      else
+      {
+        mergeRuns(runHeads[i], runTails[i], head, tail, comp);
+        head = runHeads[i];
+        tail = runTails[i];
+      }
+    }
+  }
+
+  /**
+   * Internal method to rebuild the prev links after the nodes were relinked,
+   * nothing to do unless the nodes are doubly linked
+   */
+  void relinkPrev()
+  {
+    if(!LinkPolicy::doubly)
+    {
+      return;
+    }
+
+    ListNode *prev(NULL);
+    for(ListNode *node = head_; node != NULL; node = node->next_)
+    {
+      node->setPrev(prev);
+      prev = node;
+    }
+  }
+
+  /**
+   * Internal method to iteratively reverse the count nodes starting at first,
+   * returning the reversed segment, whose tail links to NULL
+   */
+  static void reverseSegment(ListNode *first, uint32_t count, ListNode *&head, ListNode *&tail)
+  {
+    ListNode *prev(NULL);
+    ListNode *node(first);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+      ListNode *next(node->next_);
+      node->next_ = prev;
+      node->setPrev(next);
+      prev = node;
+      node = next;
+    }
+
+    head = prev;
+    head->setPrev(NULL);
+    tail = first;
+  }
+
+  /**
+   * Internal method to link the segment segmentHead..segmentTail in front of the list head..tail
+   */
+  static void prependSegment(ListNode *segmentHead, ListNode *segmentTail, ListNode *&head, ListNode *&tail)
+  {
+    if(head == NULL)
+    {
+      tail = segmentTail;
+    }
+    else
+    {
+      segmentTail->next_ = head;
+      head->setPrev(segmentTail);
+    }
+    head = segmentHead;
+  }
+
+  /**
+   * Internal method that actually performs the recursion to reverse the list
+   */
+  void reverseRecursiveInternal(ListNode *node, ListNode *&head, ListNode *&tail)
+  {
+    // recursion exit condition
+    if(node->next_ == NULL)
+    {
+      head = node;
+      tail = node;
+      node->setPrev(NULL);
+      return;
+    }
+
+    reverseRecursiveInternal(node->next_, head, tail);
+
+    tail->next_ = node;
+    node->setPrev(tail);
+    tail = node;
+    node->next_ = NULL;
+  }
+
+  /**
+   * Internal method to check if the Linked List is empty.
+   * Throws a std::length_error exception if it is empty
+   */
+  void emptyException() const
+  {
+    if(ErrorPolicy::checked && empty())
+    {
+      StatsPolicy::emptyThrown();
+      ErrorPolicy::emptyError();
+    }
+  }
+
+  /**
+   * Internal method to access the inherited stats policy
+   */
+  StatsPolicy &statsPolicy() { return *this; }
+
+  /**
+   * Internal class reporting an operation, from its construction to its destruction, to the stats policy
+   */
+  class StatsScope
+  {
+  public:
+    StatsScope(SimpleLinkedList &list, ListOp op) : list_(list), op_(op), start_(list.statsPolicy().startOp()) {}
+    ~StatsScope() { list_.statsPolicy().endOp(op_, start_, list_.size_, sizeof(ListNode)); }
+  private:
+    SimpleLinkedList &list_;
+    ListOp op_;
+    typename StatsPolicy::Timing start_;
+  };
+
+  node_allocator_type allocator_;
+  ListNode *head_;
+  ListNode *tail_;
+  uint32_t size_;
+};
 
 #endif /* SIMPLELINKEDLIST_HH_ */
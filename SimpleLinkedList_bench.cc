@@ -0,0 +1,1692 @@
+/*
+ * SimpleLinkedList_bench.cc
+ *
+ * Benchmarks for the SimpleLinkedList class and its variants
+ * Usage: SimpleLinkedList_bench [--csv|--json] [benchNameFilter]
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SimpleLinkedList.hh"
+#include "ReversibleLinkedList.hh"
+#include "CompactLinkedList.hh"
+#include "SoaLinkedList.hh"
+#include "MappedLinkedList.hh"
+#include "ListStream.hh"
+#include "IntrusiveLinkedList.hh"
+#include "ListAlgorithms.hh"
+#include "ConcurrentLinkedList.hh"
+#include "SpscLinkedList.hh"
+#include "BenchUtils.hh"
+
+// Forward declaration, implemented at the end, after all the benchmarks
+void getBenches(bench_utils::BenchCaseList &benches);
+
+int main(int argc, char **argv)
+{
+  bench_utils::BenchCaseList benches;
+  string filter;
+
+  for(int i = 1; i < argc; ++i)
+  {
+    string arg(argv[i]);
+    if(arg == "--csv")
+    {
+      bench_utils::outputFormat() = bench_utils::OUTPUT_CSV;
+    }
+    else if(arg == "--json")
+    {
+      bench_utils::outputFormat() = bench_utils::OUTPUT_JSON;
+    }
+    else
+    {
+      filter = arg;
+    }
+  }
+
+  getBenches(benches);
+  bench_utils::logHeader();
+
+  for(bench_utils::BenchCaseList::iterator benchIter = benches.begin(); benchIter != benches.end(); ++benchIter)
+  {
+    bench_utils::executeBench(*benchIter, filter);
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Reversal benchmarks
+ *
+ *******************************************************************/
+
+void BENCH_reverse_compare()
+{
+  const int rounds(10);
+  int sizes[] = {10000, 100000, 1000000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    SimpleLinkedList<int> sll;
+    for(int i = 0; i < sizes[s]; ++i)
+    {
+      sll.append(i);
+    }
+    string n(" n=" + to_string(sizes[s]));
+    uint64_t ops(uint64_t(rounds) * sizes[s]);
+
+    bench_utils::Timer timer;
+    for(int i = 0; i < rounds; ++i)
+    {
+      sll.reverseIterative();
+    }
+    bench_utils::logResult("reverse_compare", "reverseIterative" + n, ops, timer.elapsedNs());
+
+    timer.restart();
+    for(int i = 0; i < rounds; ++i)
+    {
+      sll.reverseRecursive();
+    }
+    bench_utils::logResult("reverse_compare", "reverseRecursive" + n, ops, timer.elapsedNs());
+
+    timer.restart();
+    for(int i = 0; i < rounds; ++i)
+    {
+      sll.reverseParallel();
+    }
+    bench_utils::logResult("reverse_compare",
+                           "reverseParallel " + to_string(ThreadPool::instance().size()) + " threads" + n,
+                           ops, timer.elapsedNs());
+  }
+}
+
+/*
+ * Reverse the list, then use both of its ends, rounds times
+ */
+template <class ListType>
+int64_t reverseAndPeek(ListType &list, int rounds)
+{
+  int64_t sum(0);
+  for(int i = 0; i < rounds; ++i)
+  {
+    list.reverseIterative();
+    sum += list.front() - list.back();
+  }
+  return sum;
+}
+
+// Eager reversal is O(n) per round, the lazy one O(1) whatever the size
+void BENCH_reverse_lazy()
+{
+  const int eagerRounds(100);
+  const int lazyRounds(1000000);
+  int sizes[] = {1000, 100000, 1000000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    ReversibleLinkedList<int> rll;
+    ReversibleLinkedList<int>::list_type sll;
+    for(int i = 0; i < sizes[s]; ++i)
+    {
+      sll.append(i);
+      rll.append(i);
+    }
+    string n(" n=" + to_string(sizes[s]));
+
+    bench_utils::Timer timer;
+    volatile int64_t sum(reverseAndPeek(sll, eagerRounds));
+    bench_utils::logResult("reverse_lazy", "SimpleLinkedList doubly reverse+front/back" + n, eagerRounds, timer.elapsedNs());
+
+    timer.restart();
+    sum = reverseAndPeek(rll, lazyRounds);
+    bench_utils::logResult("reverse_lazy", "ReversibleLinkedList reverse+front/back" + n, lazyRounds, timer.elapsedNs());
+
+    // The lazy reversal is paid once, by the first traversal after an odd number of reversals
+    rll.reverseIterative();
+    timer.restart();
+    for(ReversibleLinkedList<int>::iterator iter = rll.begin(); iter != rll.end(); ++iter)
+    {
+      sum = sum + *iter;
+    }
+    bench_utils::logResult("reverse_lazy", "ReversibleLinkedList relink+traversal" + n, sizes[s], timer.elapsedNs());
+    (void) sum;
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Sort benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Fill a list with items pseudo random elements, always the same ones
+ */
+template <class ListType>
+void fillRandom(ListType &sll, int items)
+{
+  srand(items);
+  for(int i = 0; i < items; ++i)
+  {
+    sll.append(rand());
+  }
+}
+
+void BENCH_sort_compare()
+{
+  int sizes[] = {10000, 100000, 1000000, 10000000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    string n(" n=" + to_string(sizes[s]));
+
+    SimpleLinkedList<int> sll;
+    fillRandom(sll, sizes[s]);
+    bench_utils::Timer timer;
+    sll.sort();
+    bench_utils::logResult("sort_compare", "sort" + n, sizes[s], timer.elapsedNs());
+
+    SimpleLinkedList<int> parallel;
+    fillRandom(parallel, sizes[s]);
+    timer.restart();
+    parallel.sortParallel();
+    bench_utils::logResult("sort_compare",
+                           "sortParallel " + to_string(ThreadPool::instance().size()) + " threads" + n,
+                           sizes[s], timer.elapsedNs());
+
+    // The baseline: copy into a vector, sort it and rebuild the list
+    SimpleLinkedList<int> copied;
+    fillRandom(copied, sizes[s]);
+    timer.restart();
+    vector<int> elements;
+    elements.reserve(copied.size());
+    for(SimpleLinkedList<int>::iterator iter = copied.begin(); iter != copied.end(); ++iter)
+    {
+      elements.push_back(*iter);
+    }
+    std::stable_sort(elements.begin(), elements.end());
+    SimpleLinkedList<int> rebuilt;
+    for(size_t i = 0; i < elements.size(); ++i)
+    {
+      rebuilt.append(elements[i]);
+    }
+    copied.reset();
+    bench_utils::logResult("sort_compare", "vector+stable_sort+rebuild" + n, sizes[s], timer.elapsedNs());
+
+    sll.reset();
+    parallel.reset();
+    rebuilt.reset();
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Traversal benchmarks
+ *
+ *******************************************************************/
+
+void BENCH_traversal_prefetch()
+{
+  // The largest lists take hundreds of MB, far more than the last level cache
+  int sizes[] = {100000, 1000000, 10000000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    string n(" n=" + to_string(sizes[s]));
+
+    // Sorting random elements scatters the nodes in memory, defeating the hardware prefetcher
+    SimpleLinkedList<int> sll;
+    fillRandom(sll, sizes[s]);
+    sll.sort();
+
+    int64_t sum(0);
+    bench_utils::Timer timer;
+    for(SimpleLinkedList<int>::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+    {
+      sum += *iter;
+    }
+    bench_utils::logResult("traversal_prefetch", "iterator loop" + n, sizes[s], timer.elapsedNs());
+    bench_utils::doNotOptimize(sum);
+
+    sum = 0;
+    timer.restart();
+    prefetch_for_each(sll.begin(), sll.end(), [&sum](int value) { sum += value; });
+    bench_utils::logResult("traversal_prefetch", "prefetch_for_each" + n, sizes[s], timer.elapsedNs());
+    bench_utils::doNotOptimize(sum);
+
+    timer.restart();
+    JumpIndex<SimpleLinkedList<int>::iterator> index(sll.begin(), sll.end());
+    bench_utils::logResult("traversal_prefetch", "JumpIndex build" + n, sizes[s], timer.elapsedNs());
+
+    sum = 0;
+    timer.restart();
+    prefetch_for_each(index, [&sum](int value) { sum += value; });
+    bench_utils::logResult("traversal_prefetch", "JumpIndex prefetch_for_each" + n, sizes[s], timer.elapsedNs());
+    bench_utils::doNotOptimize(sum);
+
+    timer.restart();
+    sum = prefetch_reduce(index, int64_t(0), std::plus<int64_t>());
+    bench_utils::logResult("traversal_prefetch", "JumpIndex prefetch_reduce" + n, sizes[s], timer.elapsedNs());
+    bench_utils::doNotOptimize(sum);
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        SoA scan benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Time the sum, the count of one value and the search of the last element of list
+ */
+template <class ListType>
+void runScans(ListType &list, const string &variant, int items)
+{
+  bench_utils::Timer timer;
+  int64_t sum(list.sum());
+  bench_utils::logResult("soa_scans", variant + " sum n=" + to_string(items), items, timer.elapsedNs());
+  bench_utils::doNotOptimize(sum);
+
+  timer.restart();
+  uint32_t count(list.count(7));
+  bench_utils::logResult("soa_scans", variant + " count n=" + to_string(items), items, timer.elapsedNs());
+  bench_utils::doNotOptimize(count);
+
+  timer.restart();
+  bool found(list.find(items - 1) != list.end());
+  bench_utils::logResult("soa_scans", variant + " find n=" + to_string(items), items, timer.elapsedNs());
+  bench_utils::doNotOptimize(found);
+}
+
+/*
+ * The scalar scans of a SimpleLinkedList, with the ListIterator
+ */
+struct IteratorScans
+{
+  IteratorScans(SimpleLinkedList<int> &list) : list_(list) {}
+
+  int64_t sum()
+  {
+    int64_t total(0);
+    for(SimpleLinkedList<int>::iterator iter = list_.begin(); iter != list_.end(); iter.increment())
+    {
+      total += *iter;
+    }
+    return total;
+  }
+
+  uint32_t count(int value)
+  {
+    uint32_t total(0);
+    for(SimpleLinkedList<int>::iterator iter = list_.begin(); iter != list_.end(); iter.increment())
+    {
+      total += (*iter == value);
+    }
+    return total;
+  }
+
+  SimpleLinkedList<int>::iterator find(int value) { return std::find(list_.begin(), list_.end(), value); }
+  SimpleLinkedList<int>::iterator end() { return list_.end(); }
+
+  SimpleLinkedList<int> &list_;
+};
+
+void BENCH_soa_scans()
+{
+  int sizes[] = {10000, 1000000, 10000000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    // The nodes are appended in order, the best case for the ListIterator walk
+    SimpleLinkedList<int> sll;
+    SoaLinkedList<int> ordered;
+    SoaLinkedList<int> unordered;
+    for(int i = 0; i < sizes[s]; ++i)
+    {
+      sll.append(i);
+      ordered.append(i);
+      unordered.insert(sizes[s] - 1 - i);
+    }
+
+    IteratorScans scans(sll);
+    runScans(scans, "SimpleLinkedList ListIterator", sizes[s]);
+    runScans(unordered, "SoaLinkedList links", sizes[s]);
+#if defined(SOA_AVX2)
+    runScans(ordered, soaHasAvx2() ? "SoaLinkedList AVX2" : "SoaLinkedList SSE2", sizes[s]);
+#else
+    runScans(ordered, "SoaLinkedList kernels", sizes[s]);
+#endif
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Parallel algorithm benchmarks
+ *
+ *******************************************************************/
+
+void BENCH_parallel_scaling()
+{
+  const int n(10000000);
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < n; ++i)
+  {
+    sll.append(i);
+  }
+
+  bench_utils::Timer timer;
+  int64_t serial(0);
+  for(SimpleLinkedList<int>::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+  {
+    serial += *iter;
+  }
+  bench_utils::logResult("parallel_scaling", "serial reduce n=" + to_string(n), n, timer.elapsedNs());
+  bench_utils::doNotOptimize(serial);
+
+  timer.restart();
+  JumpIndex<SimpleLinkedList<int>::iterator> index(split_points(sll));
+  bench_utils::logResult("parallel_scaling", "split_points n=" + to_string(n), n, timer.elapsedNs());
+
+  // From 1 thread to all the hardware threads, doubling
+  unsigned maxThreads(std::max(1u, std::thread::hardware_concurrency()));
+  vector<unsigned> threadCounts;
+  for(unsigned threads = 1; threads < maxThreads; threads *= 2)
+  {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+
+  for(size_t t = 0; t < threadCounts.size(); ++t)
+  {
+    ThreadPool pool(threadCounts[t]);
+    string params(" " + to_string(threadCounts[t]) + " threads n=" + to_string(n));
+
+    timer.restart();
+    int64_t sum(parallel_reduce(index, int64_t(0), std::plus<int64_t>(), pool));
+    bench_utils::logResult("parallel_scaling", "parallel_reduce" + params, n, timer.elapsedNs());
+    bench_utils::doNotOptimize(sum);
+
+    timer.restart();
+    uint32_t count(parallel_count_if(index, [](int value) { return value % 3 == 0; }, pool));
+    bench_utils::logResult("parallel_scaling", "parallel_count_if" + params, n, timer.elapsedNs());
+    bench_utils::doNotOptimize(count);
+
+    timer.restart();
+    parallel_transform(index, [](int value) { return value ^ 1; }, pool);
+    bench_utils::logResult("parallel_scaling", "parallel_transform" + params, n, timer.elapsedNs());
+
+    std::atomic<uint32_t> odd(0);
+    timer.restart();
+    parallel_for_each(index, [&odd](int value) { if(value & 1) { odd.fetch_add(1, std::memory_order_relaxed); } }, pool);
+    bench_utils::logResult("parallel_scaling", "parallel_for_each" + params, n, timer.elapsedNs());
+    bench_utils::doNotOptimize(odd);
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Compaction benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Return the time to sum the elements of the list, following the links
+ */
+template <class ListType>
+double timeTraversal(ListType &sll)
+{
+  int64_t sum(0);
+  bench_utils::Timer timer;
+  for(typename ListType::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+  {
+    sum += *iter;
+  }
+  bench_utils::doNotOptimize(sum);
+
+  return timer.elapsedNs();
+}
+
+/*
+ * Traverse a scattered list of n elements, then compact it, at once or incrementally,
+ * and traverse it again
+ */
+template <class ListType>
+void runCompact(const string &variant, int items)
+{
+  string n(" n=" + to_string(items));
+
+  // Sorting random elements scatters the nodes in memory, like a long mix of inserts and removals
+  ListType sll;
+  fillRandom(sll, items);
+  sll.sort();
+  bench_utils::logResult("compact_traversal", variant + " scattered traversal" + n, items, timeTraversal(sll));
+
+  bench_utils::Timer timer;
+  sll.compact();
+  bench_utils::logResult("compact_traversal", variant + " compact" + n, items, timer.elapsedNs());
+  bench_utils::logResult("compact_traversal", variant + " compacted traversal" + n, items, timeTraversal(sll));
+
+  // The same in 1ms steps, the time is the total of the steps
+  ListType incremental;
+  fillRandom(incremental, items);
+  incremental.sort();
+  typename ListType::iterator position;
+  uint32_t steps(1);
+  timer.restart();
+  while(!incremental.compact_for(std::chrono::milliseconds(1), position))
+  {
+    ++steps;
+  }
+  bench_utils::logResult("compact_traversal", variant + " compact_for 1ms x" + to_string(steps) + n,
+                         items, timer.elapsedNs());
+  bench_utils::logResult("compact_traversal", variant + " incrementally compacted traversal" + n,
+                         items, timeTraversal(incremental));
+}
+
+void BENCH_compact_traversal()
+{
+  int sizes[] = {1000000, 10000000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    runCompact<SimpleLinkedList<int> >("HeapAllocator", sizes[s]);
+    runCompact<SimpleLinkedList<int, PoolAllocator<int> > >("PoolAllocator", sizes[s]);
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Link policy benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Fill a list with items elements then drain it from the back
+ */
+template <class ListType>
+void runDrainBack(const string &variant, int items)
+{
+  ListType sll;
+  for(int i = 0; i < items; ++i)
+  {
+    sll.append(i);
+  }
+
+  bench_utils::Timer timer;
+  while(!sll.empty())
+  {
+    sll.pop_back();
+  }
+
+  bench_utils::logResult("link_popBackDrain", variant + " n=" + to_string(items), items, timer.elapsedNs());
+}
+
+void BENCH_link_popBackDrain()
+{
+  runDrainBack<SimpleLinkedList<int> >("SinglyLinked", 10000);
+  runDrainBack<SimpleLinkedList<int> >("SinglyLinked", 30000);
+  runDrainBack<SimpleLinkedList<int, HeapAllocator<int>, DoublyLinked> >("DoublyLinked", 10000);
+  runDrainBack<SimpleLinkedList<int, HeapAllocator<int>, DoublyLinked> >("DoublyLinked", 30000);
+  runDrainBack<SimpleLinkedList<int, HeapAllocator<int>, DoublyLinked> >("DoublyLinked", 1000000);
+}
+
+
+/********************************************************************
+ *
+ *                        Copy benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * A heavy payload counting how many times it is constructed, copied and moved.
+ * Moving it is cheap, since its buffer is on the heap.
+ */
+struct HeavyPayload
+{
+  HeavyPayload(int value) : buffer_(PAYLOAD_SIZE, char(value)) { ++constructed; }
+  HeavyPayload(const HeavyPayload &other) : buffer_(other.buffer_) { ++copied; }
+  HeavyPayload(HeavyPayload &&other) : buffer_(std::move(other.buffer_)) { ++moved; }
+  static void resetCounts() { constructed = copied = moved = 0; }
+  static const size_t PAYLOAD_SIZE = 1024;
+  vector<char> buffer_;
+  static uint64_t constructed;
+  static uint64_t copied;
+  static uint64_t moved;
+};
+uint64_t HeavyPayload::constructed(0);
+uint64_t HeavyPayload::copied(0);
+uint64_t HeavyPayload::moved(0);
+
+/*
+ * Fill a list with items payloads using addFunc, log the time and the copy counts
+ */
+template <class AddFunc>
+void runCopyCount(const string &variant, int items, AddFunc addFunc)
+{
+  SimpleLinkedList<HeavyPayload> sll;
+  HeavyPayload::resetCounts();
+
+  bench_utils::Timer timer;
+  for(int i = 0; i < items; ++i)
+  {
+    addFunc(sll, i);
+  }
+  uint64_t sum(0);
+  for(int i = 0; i < items; ++i)
+  {
+    // front() returns a reference, it must not copy
+    sum += sll.front().buffer_[0];
+    sll.pop_front();
+  }
+  double ns(timer.elapsedNs());
+  bench_utils::doNotOptimize(sum);
+
+  bench_utils::logResult("move_copyCount", variant, items, ns);
+  cout << "       constructed/op=" << double(HeavyPayload::constructed) / items
+       << ", copied/op=" << double(HeavyPayload::copied) / items
+       << ", moved/op=" << double(HeavyPayload::moved) / items << endl;
+}
+
+void BENCH_move_copyCount()
+{
+  const int items(100000);
+
+  runCopyCount("append(const T&)", items, [](SimpleLinkedList<HeavyPayload> &sll, int i) {
+    HeavyPayload payload(i);
+    sll.append(payload);
+  });
+  runCopyCount("append(T&&)", items, [](SimpleLinkedList<HeavyPayload> &sll, int i) {
+    sll.append(HeavyPayload(i));
+  });
+  runCopyCount("emplace_back(args)", items, [](SimpleLinkedList<HeavyPayload> &sll, int i) {
+    sll.emplace_back(i);
+  });
+}
+
+
+/********************************************************************
+ *
+ *                        Stats benchmarks
+ *
+ *******************************************************************/
+
+// NoStats must not make the list any bigger than its allocator, 2 pointers and the size
+struct BareList
+{
+  HeapAllocator<int> allocator_;
+  void *head_;
+  void *tail_;
+  uint32_t size_;
+};
+static_assert(sizeof(SimpleLinkedList<int>) == sizeof(BareList), "NoStats takes memory");
+
+/*
+ * Append then pop_front items elements, rounds times
+ */
+template <class ListType>
+void runAppendPop(const string &variant, int items, int rounds)
+{
+  ListType sll;
+  bench_utils::Timer timer;
+  for(int r = 0; r < rounds; ++r)
+  {
+    for(int i = 0; i < items; ++i)
+    {
+      sll.append(i);
+    }
+    while(!sll.empty())
+    {
+      sll.pop_front();
+    }
+  }
+  bench_utils::logResult("stats_overhead", variant + " append+pop_front", uint64_t(items) * rounds, timer.elapsedNs());
+}
+
+void BENCH_stats_overhead()
+{
+  const int items(1000);
+  const int rounds(1000);
+
+  // NoStats compiles to nothing, so its times are those of the list without any instrumentation
+  runAppendPop<SimpleLinkedList<int, PoolAllocator<int> > >("NoStats", items, rounds);
+  runAppendPop<SimpleLinkedList<int, PoolAllocator<int>, SinglyLinked, CountingStats> >("CountingStats", items, rounds);
+  runAppendPop<SimpleLinkedList<int> >("NoStats HeapAllocator", items, rounds);
+  runAppendPop<SimpleLinkedList<int, HeapAllocator<int>, SinglyLinked, CountingStats> >("CountingStats HeapAllocator",
+                                                                                       items, rounds);
+}
+
+
+/********************************************************************
+ *
+ *                        Error policy benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Fill the list with items elements then drain it with drain(), rounds times.
+ * Only the draining is measured, in ns and in instructions when available.
+ */
+template <class ListType, class Drain>
+void runDrain(const string &variant, int items, int rounds, Drain drain)
+{
+  ListType sll;
+  bench_utils::InstructionCounter counter;
+  double ns(0);
+  int64_t instructions(0);
+  int64_t sum(0);
+
+  for(int r = 0; r < rounds; ++r)
+  {
+    for(int i = 0; i < items; ++i)
+    {
+      sll.append(i);
+    }
+
+    bench_utils::Timer timer;
+    counter.start();
+    sum += drain(sll);
+    instructions += counter.stop();
+    ns += timer.elapsedNs();
+  }
+  bench_utils::doNotOptimize(sum);
+
+  uint64_t ops(uint64_t(items) * rounds);
+  bench_utils::logResult("errors_drain", variant, ops, ns);
+  if(counter.available())
+  {
+    bench_utils::logInstructions("errors_drain", variant, ops, instructions);
+  }
+}
+
+/*
+ * Sum the elements, then remove them with front() and pop_front()
+ */
+template <class ListType>
+int64_t frontPopDrain(ListType &sll)
+{
+  int64_t sum(0);
+  for(typename ListType::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    sum += *iter;
+  }
+  while(!sll.empty())
+  {
+    sum += sll.front();
+    sll.pop_front();
+  }
+  return sum;
+}
+
+/*
+ * Sum the elements, then remove them with try_pop_front()
+ */
+template <class ListType>
+int64_t tryPopDrain(ListType &sll)
+{
+  int64_t sum(0);
+  for(typename ListType::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    sum += *iter;
+  }
+  int value;
+  while(sll.try_pop_front(value))
+  {
+    sum += value;
+  }
+  return sum;
+}
+
+void BENCH_errors_drain()
+{
+  const int items(1000);
+  const int rounds(1000);
+  typedef SimpleLinkedList<int, PoolAllocator<int> > ThrowingList;
+  typedef SimpleLinkedList<int, PoolAllocator<int>, SinglyLinked, NoStats, NoThrowOnEmpty> NoThrowList;
+
+  if(!bench_utils::InstructionCounter().available())
+  {
+    cerr << "       instruction counts not available, perf_event_open() failed" << endl;
+  }
+
+  runDrain<ThrowingList>("ThrowOnEmpty iterate+front+pop_front", items, rounds, frontPopDrain<ThrowingList>);
+  runDrain<ThrowingList>("ThrowOnEmpty iterate+try_pop_front", items, rounds, tryPopDrain<ThrowingList>);
+  runDrain<NoThrowList>("NoThrowOnEmpty iterate+front+pop_front", items, rounds, frontPopDrain<NoThrowList>);
+  runDrain<NoThrowList>("NoThrowOnEmpty iterate+try_pop_front", items, rounds, tryPopDrain<NoThrowList>);
+}
+
+
+/********************************************************************
+ *
+ *                        Bulk insertion benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Build a list from a vector of items elements, with a per-element append loop then with append_range()
+ */
+template <class ListType>
+void runBulkAppend(const string &variant, const vector<int> &elements)
+{
+  string n(" n=" + to_string(elements.size()));
+
+  bench_utils::Timer timer;
+  {
+    ListType sll;
+    for(size_t i = 0; i < elements.size(); ++i)
+    {
+      sll.append(elements[i]);
+    }
+    bench_utils::doNotOptimize(sll.back());
+  }
+  bench_utils::logResult("range_appendCompare", variant + " append loop" + n, elements.size(), timer.elapsedNs());
+
+  timer.restart();
+  {
+    ListType sll;
+    sll.append_range(elements.begin(), elements.end());
+    bench_utils::doNotOptimize(sll.back());
+  }
+  bench_utils::logResult("range_appendCompare", variant + " append_range" + n, elements.size(), timer.elapsedNs());
+}
+
+void BENCH_range_appendCompare()
+{
+  vector<int> elements;
+  for(int i = 0; i < 1000000; ++i)
+  {
+    elements.push_back(i);
+  }
+
+  // Each list is destroyed inside its timed scope
+  runBulkAppend<SimpleLinkedList<int> >("HeapAllocator", elements);
+  runBulkAppend<SimpleLinkedList<int, PoolAllocator<int> > >("PoolAllocator", elements);
+}
+
+
+/********************************************************************
+ *
+ *                        Small list benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Create many short lists of items elements: fill, sum and destroy each one
+ */
+template <class ListType>
+void runSmallLists(const string &variant, int items)
+{
+  const int lists(200000);
+  int64_t sum(0);
+
+  bench_utils::Timer timer;
+  for(int l = 0; l < lists; ++l)
+  {
+    ListType sll;
+    for(int i = 0; i < items; ++i)
+    {
+      sll.append(i);
+    }
+    for(typename ListType::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+    {
+      sum += *iter;
+    }
+  }
+  bench_utils::logResult("small_lists", variant + " n=" + to_string(items), int64_t(lists) * items, timer.elapsedNs());
+  bench_utils::doNotOptimize(sum);
+}
+
+void BENCH_small_lists()
+{
+  for(int items = 1; items <= 16; items *= 2)
+  {
+    runSmallLists<SimpleLinkedList<int> >("HeapAllocator", items);
+    runSmallLists<SimpleLinkedList<int, PoolAllocator<int, 16> > >("PoolAllocator", items);
+    runSmallLists<SimpleLinkedList<int, InlineAllocator<int, 8> > >("InlineAllocator 8", items);
+    runSmallLists<SimpleLinkedList<int, InlineAllocator<int, 16> > >("InlineAllocator 16", items);
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Filter benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Remove the elements not divisible by keepEvery from a list of n elements: with remove_if(),
+ * with an erase_after() loop, and by rebuilding a new list of the kept elements
+ */
+template <class ListType>
+void runFilter(const string &variant, int n, int keepEvery)
+{
+  string params(" n=" + to_string(n) + " keep 1/" + to_string(keepEvery));
+  auto dropped = [keepEvery](int value) { return value % keepEvery != 0; };
+
+  // Only the filtering is timed, not filling the list
+  ListType sll;
+  for(int i = 0; i < n; ++i)
+  {
+    sll.append(i);
+  }
+  bench_utils::Timer timer;
+  sll.remove_if(dropped);
+  bench_utils::logResult("filter_compare", variant + " remove_if" + params, n, timer.elapsedNs());
+  bench_utils::doNotOptimize(sll.size());
+
+  sll.reset();
+  for(int i = 0; i < n; ++i)
+  {
+    sll.append(i);
+  }
+  timer.restart();
+  // The head is never dropped, since 0 is kept
+  typename ListType::iterator prev(sll.begin());
+  typename ListType::iterator iter(std::next(prev));
+  while(iter != sll.end())
+  {
+    if(dropped(*iter))
+    {
+      iter = sll.erase_after(prev);
+    }
+    else
+    {
+      prev = iter;
+      iter.increment();
+    }
+  }
+  bench_utils::logResult("filter_compare", variant + " erase_after loop" + params, n, timer.elapsedNs());
+  bench_utils::doNotOptimize(sll.size());
+
+  sll.reset();
+  for(int i = 0; i < n; ++i)
+  {
+    sll.append(i);
+  }
+  timer.restart();
+  {
+    ListType kept(sll.get_allocator());
+    for(typename ListType::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+    {
+      if(!dropped(*iter))
+      {
+        kept.append(*iter);
+      }
+    }
+    sll = std::move(kept);
+  }
+  bench_utils::logResult("filter_compare", variant + " rebuild" + params, n, timer.elapsedNs());
+  bench_utils::doNotOptimize(sll.size());
+}
+
+void BENCH_filter_compare()
+{
+  const int n(1000000);
+  const int keepEvery[] = {2, 10, 1000};
+  for(size_t i = 0; i < sizeof(keepEvery) / sizeof(keepEvery[0]); ++i)
+  {
+    runFilter<SimpleLinkedList<int> >("HeapAllocator", n, keepEvery[i]);
+    runFilter<SimpleLinkedList<int, PoolAllocator<int> > >("PoolAllocator", n, keepEvery[i]);
+  }
+}
+
+/********************************************************************
+ *
+ *                        Startup benchmarks
+ *
+ *******************************************************************/
+
+void BENCH_startup_mappedReload()
+{
+  int sizes[] = {1000000, 10000000};
+  const string path("/tmp/SimpleLinkedList_bench_" + to_string(getpid()) + ".map");
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    string n(" n=" + to_string(sizes[s]));
+
+    // The baseline: rebuilding the list, then reading it once
+    bench_utils::Timer timer;
+    SimpleLinkedList<int> sll;
+    for(int i = 0; i < sizes[s]; ++i)
+    {
+      sll.append(i);
+    }
+    bench_utils::logResult("startup_mappedReload", "append rebuild" + n, sizes[s], timer.elapsedNs());
+
+    int64_t sum(0);
+    timer.restart();
+    for(SimpleLinkedList<int>::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+    {
+      sum += *iter;
+    }
+    bench_utils::logResult("startup_mappedReload", "append traversal" + n, sizes[s], timer.elapsedNs());
+    bench_utils::doNotOptimize(sum);
+
+    timer.restart();
+    MappedLinkedList<int>::save(sll, path);
+    bench_utils::logResult("startup_mappedReload", "save" + n, sizes[s], timer.elapsedNs());
+    sll.reset();
+
+    // The file was just written, it's in the page cache: the first traversal maps the pages without reading the disk
+    ListMapMode modes[] = {LIST_MAP_READ_ONLY, LIST_MAP_COPY_ON_WRITE};
+    const char *modeNames[] = {"read-only", "copy-on-write"};
+    for(int m = 0; m < 2; ++m)
+    {
+      timer.restart();
+      MappedLinkedList<int> mll(path, modes[m]);
+      bench_utils::doNotOptimize(mll.front());
+      bench_utils::logResult("startup_mappedReload", string("mmap ") + modeNames[m] + " open" + n, sizes[s], timer.elapsedNs());
+
+      sum = 0;
+      timer.restart();
+      for(MappedLinkedList<int>::iterator iter = mll.begin(); iter != mll.end(); iter.increment())
+      {
+        sum += *iter;
+      }
+      bench_utils::logResult("startup_mappedReload", string("mmap ") + modeNames[m] + " first traversal" + n, sizes[s], timer.elapsedNs());
+      bench_utils::doNotOptimize(sum);
+    }
+    std::remove(path.c_str());
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Stream benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Time writing list to a new file at path, then reading it back into a ListType, in format
+ */
+template <class ListType>
+void runStream(SimpleLinkedList<int> &list, const string &path, ListStreamFormat format, const string &variant)
+{
+  const string n(" n=" + to_string(list.size()));
+  int fd(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600));
+  uint64_t bytes;
+  {
+    bench_utils::Timer timer;
+    ListStreamWriter<int> writer(fd, format);
+    writer.write_all(list);
+    writer.flush();
+    bytes = writer.bytes_written();
+    bench_utils::logThroughput("stream_throughput", variant + " write" + n, list.size(), timer.elapsedNs(), bytes);
+  }
+
+  ::lseek(fd, 0, SEEK_SET);
+  bench_utils::Timer timer;
+  ListType loaded;
+  ListStreamReader<int>(fd, format).read_all(loaded);
+  bench_utils::logThroughput("stream_throughput", variant + " read" + n, loaded.size(), timer.elapsedNs(), bytes);
+  ::close(fd);
+}
+
+void BENCH_stream_throughput()
+{
+  const int items(10000000);
+  const string path("/tmp/SimpleLinkedList_bench_" + to_string(getpid()) + ".stream");
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < items; ++i)
+  {
+    sll.append(i * 37);
+  }
+
+  runStream<SimpleLinkedList<int> >(sll, path, LIST_STREAM_BINARY, "binary HeapAllocator");
+  runStream<SimpleLinkedList<int, PoolAllocator<int> > >(sll, path, LIST_STREAM_BINARY, "binary PoolAllocator");
+  runStream<SimpleLinkedList<int> >(sll, path, LIST_STREAM_TEXT, "text HeapAllocator");
+
+  // The baseline for the reader: the same reads, with one append() per element
+  int fd(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600));
+  {
+    ListStreamWriter<int> writer(fd);
+    writer.write_all(sll);
+  }
+  ::lseek(fd, 0, SEEK_SET);
+  bench_utils::Timer timer;
+  SimpleLinkedList<int> appended;
+  std::vector<int> buffer(LIST_STREAM_BUFFER_SIZE / sizeof(int));
+  ssize_t count(::read(fd, &buffer[0], 16));
+  while((count = ::read(fd, &buffer[0], buffer.size() * sizeof(int))) > 0)
+  {
+    for(ssize_t i = 0; i < count / ssize_t(sizeof(int)); ++i)
+    {
+      appended.append(buffer[i]);
+    }
+  }
+  bench_utils::logThroughput("stream_throughput", "binary append() per element read n=" + to_string(items),
+                             appended.size(), timer.elapsedNs(), uint64_t(items) * sizeof(int));
+  ::close(fd);
+  std::remove(path.c_str());
+
+  // The baseline for the writer: one write() per element, on fewer elements
+  const int unbuffered(100000);
+  fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  timer.restart();
+  SimpleLinkedList<int>::iterator iter(sll.begin());
+  for(int i = 0; i < unbuffered; ++i, iter.increment())
+  {
+    listWriteAll(fd, reinterpret_cast<const char*>(&(*iter)), sizeof(int), "can't write " + path);
+  }
+  bench_utils::logThroughput("stream_throughput", "binary write() per element n=" + to_string(unbuffered),
+                             unbuffered, timer.elapsedNs(), uint64_t(unbuffered) * sizeof(int));
+  ::close(fd);
+  std::remove(path.c_str());
+
+  // Through a pipe, the list is rebuilt while it's written
+  int fds[2];
+  if(::pipe(fds) != 0)
+  {
+    return;
+  }
+  timer.restart();
+  std::thread writerThread([&sll, &fds]() {
+    ListStreamWriter<int> writer(fds[1]);
+    writer.write_all(sll);
+    writer.flush();
+    ::close(fds[1]);
+  });
+  SimpleLinkedList<int> received;
+  uint64_t bytes;
+  {
+    ListStreamReader<int> reader(fds[0]);
+    reader.read_all(received);
+    bytes = reader.bytes_read();
+  }
+  writerThread.join();
+  bench_utils::logThroughput("stream_throughput", "binary pipe n=" + to_string(items), received.size(), timer.elapsedNs(), bytes);
+  ::close(fds[0]);
+}
+
+
+/********************************************************************
+ *
+ *                        Intrusive list benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * An object already allocated in a pool, which can be linked in an intrusive list
+ */
+struct PooledObject : public IntrusiveListHook
+{
+  PooledObject(int key) : key_(key), payload_() {}
+  int key_;
+  char payload_[60];
+};
+
+/*
+ * Link then unlink all the pooled objects, rounds times
+ */
+template <class ListType, class Link>
+void runLinkUnlink(const string &variant, vector<PooledObject> &objects, int rounds, Link link)
+{
+  ListType sll;
+  int64_t sum(0);
+  bench_utils::Timer timer;
+  for(int r = 0; r < rounds; ++r)
+  {
+    for(size_t i = 0; i < objects.size(); ++i)
+    {
+      link(sll, objects[i]);
+    }
+    while(!sll.empty())
+    {
+      sum += sll.front().key_;
+      sll.pop_front();
+    }
+  }
+  bench_utils::doNotOptimize(sum);
+  bench_utils::logResult("intrusive_linkUnlink", variant, uint64_t(objects.size()) * rounds, timer.elapsedNs());
+}
+
+void BENCH_intrusive_linkUnlink()
+{
+  const int rounds(100);
+  vector<PooledObject> objects;
+  for(int i = 0; i < 10000; ++i)
+  {
+    objects.push_back(PooledObject(i));
+  }
+
+  runLinkUnlink<IntrusiveLinkedList<PooledObject> >("IntrusiveLinkedList", objects, rounds,
+      [](IntrusiveLinkedList<PooledObject> &sll, PooledObject &object) { sll.append(object); });
+  runLinkUnlink<SimpleLinkedList<PooledObject> >("SimpleLinkedList copies", objects, rounds,
+      [](SimpleLinkedList<PooledObject> &sll, PooledObject &object) { sll.append(object); });
+  runLinkUnlink<SimpleLinkedList<PooledObject, PoolAllocator<PooledObject> > >("SimpleLinkedList+PoolAllocator copies",
+      objects, rounds,
+      [](SimpleLinkedList<PooledObject, PoolAllocator<PooledObject> > &sll, PooledObject &object) { sll.append(object); });
+}
+
+
+/********************************************************************
+ *
+ *                        Container comparison benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * An element of Bytes bytes, the key is used to check the elements are really read
+ */
+template <size_t Bytes>
+struct Payload
+{
+  Payload(int key) : key_(key) {}
+  int key_;
+  char padding_[Bytes - sizeof(int)];
+};
+
+/*
+ * The operations each container supports in O(1), the others are not benchmarked
+ */
+template <class Container>
+struct ContainerTraits
+{
+  static const bool APPEND = true;
+  static const bool POP_BACK = true;
+};
+
+template <class T>
+struct ContainerTraits<forward_list<T> >
+{
+  static const bool APPEND = false;
+  static const bool POP_BACK = false;
+};
+
+// Singly linked pop_back() is O(n), see BENCH_link_popBackDrain
+template <class T, class Allocator>
+struct ContainerTraits<SimpleLinkedList<T, Allocator, SinglyLinked> >
+{
+  static const bool APPEND = true;
+  static const bool POP_BACK = false;
+};
+
+/*
+ * Adapters giving all the containers the same interface.
+ * Those for operations a container doesn't support are never called.
+ */
+template <class Container, class T>
+void pushFront(Container &c, const T &value) { c.push_front(value); }
+
+template <class T, class Allocator, class LinkPolicy>
+void pushFront(SimpleLinkedList<T, Allocator, LinkPolicy> &c, const T &value) { c.insert(value); }
+
+template <class Container, class T>
+void pushBack(Container &c, const T &value) { c.push_back(value); }
+
+template <class T, class Allocator, class LinkPolicy>
+void pushBack(SimpleLinkedList<T, Allocator, LinkPolicy> &c, const T &value) { c.append(value); }
+
+template <class T>
+void pushBack(forward_list<T> &, const T &) {}
+
+template <class Container>
+void clearAll(Container &c) { c.clear(); }
+
+template <class T, class Allocator, class LinkPolicy>
+void clearAll(SimpleLinkedList<T, Allocator, LinkPolicy> &c) { c.reset(); }
+
+template <class Container>
+void popBack(Container &c) { c.pop_back(); }
+
+template <class T>
+void popBack(forward_list<T> &) {}
+
+template <class Container>
+void reverseAll(Container &c) { std::reverse(c.begin(), c.end()); }
+
+template <class T>
+void reverseAll(list<T> &c) { c.reverse(); }
+
+template <class T>
+void reverseAll(forward_list<T> &c) { c.reverse(); }
+
+template <class T, class Allocator, class LinkPolicy>
+void reverseAll(SimpleLinkedList<T, Allocator, LinkPolicy> &c) { c.reverseIterative(); }
+
+template <class Container>
+int64_t sumKeys(Container &c)
+{
+  int64_t sum(0);
+  for(typename Container::iterator iter = c.begin(); iter != c.end(); ++iter)
+  {
+    sum += iter->key_;
+  }
+  return sum;
+}
+
+/*
+ * Measure each operation on a container of items elements, repeated so
+ * that about a million operations are timed, in a child process to also
+ * measure the peak memory used
+ */
+template <class Container>
+void runContainerOps(const string &variant, int items)
+{
+  typedef typename Container::value_type Element;
+  const int rounds(std::max(1, 1000000 / items));
+  const uint64_t ops(uint64_t(rounds) * items);
+  const string bench("containers_compare");
+  const string name(variant + " bytes=" + to_string(sizeof(Element)) + " n=" + to_string(items));
+
+  bench_utils::runIsolated(bench, name, [&]() {
+    Container c;
+
+    bench_utils::Timer timer;
+    for(int r = 0; r < rounds; ++r)
+    {
+      if(r > 0)
+      {
+        clearAll(c);
+      }
+      for(int i = 0; i < items; ++i)
+      {
+        pushFront(c, Element(i));
+      }
+    }
+    bench_utils::logResult(bench, name + " insert", ops, timer.elapsedNs());
+
+    int64_t sum(0);
+    timer.restart();
+    for(int r = 0; r < rounds; ++r)
+    {
+      sum += sumKeys(c);
+    }
+    bench_utils::logResult(bench, name + " iterate", ops, timer.elapsedNs());
+    bench_utils::doNotOptimize(sum);
+
+    timer.restart();
+    for(int r = 0; r < rounds; ++r)
+    {
+      reverseAll(c);
+    }
+    bench_utils::logResult(bench, name + " reverse", ops, timer.elapsedNs());
+
+    // Only the draining is timed, not refilling the container
+    double ns(0);
+    for(int r = 0; r < rounds; ++r)
+    {
+      if(r > 0)
+      {
+        for(int i = 0; i < items; ++i)
+        {
+          pushFront(c, Element(i));
+        }
+      }
+      timer.restart();
+      while(!c.empty())
+      {
+        c.pop_front();
+      }
+      ns += timer.elapsedNs();
+    }
+    bench_utils::logResult(bench, name + " pop_front", ops, ns);
+
+    if(ContainerTraits<Container>::APPEND)
+    {
+      timer.restart();
+      for(int r = 0; r < rounds; ++r)
+      {
+        if(r > 0)
+        {
+          clearAll(c);
+        }
+        for(int i = 0; i < items; ++i)
+        {
+          pushBack(c, Element(i));
+        }
+      }
+      bench_utils::logResult(bench, name + " append", ops, timer.elapsedNs());
+    }
+
+    if(ContainerTraits<Container>::POP_BACK)
+    {
+      ns = 0;
+      for(int r = 0; r < rounds; ++r)
+      {
+        if(r > 0)
+        {
+          for(int i = 0; i < items; ++i)
+          {
+            pushBack(c, Element(i));
+          }
+        }
+        timer.restart();
+        while(!c.empty())
+        {
+          popBack(c);
+        }
+        ns += timer.elapsedNs();
+      }
+      bench_utils::logResult(bench, name + " pop_back", ops, ns);
+    }
+  });
+}
+
+/*
+ * Run the operations on all the containers, with elements of Bytes bytes
+ */
+template <size_t Bytes>
+void runContainersCompare(int items)
+{
+  typedef Payload<Bytes> Element;
+
+  runContainerOps<SimpleLinkedList<Element> >("SimpleLinkedList", items);
+  runContainerOps<SimpleLinkedList<Element, PoolAllocator<Element> > >("SimpleLinkedList+PoolAllocator", items);
+  runContainerOps<SimpleLinkedList<Element, HeapAllocator<Element>, DoublyLinked> >("SimpleLinkedList+DoublyLinked", items);
+  runContainerOps<list<Element> >("std::list", items);
+  runContainerOps<forward_list<Element> >("std::forward_list", items);
+  runContainerOps<deque<Element> >("std::deque", items);
+}
+
+void BENCH_containers_compare()
+{
+  // Keep the containers under about 64MB of elements
+  const size_t maxBytes(64 << 20);
+  int sizes[] = {1000, 100000, 1000000};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    runContainersCompare<8>(sizes[s]);
+    if(size_t(sizes[s]) * 64 <= maxBytes)
+    {
+      runContainersCompare<64>(sizes[s]);
+    }
+    if(size_t(sizes[s]) * 256 <= maxBytes)
+    {
+      runContainersCompare<256>(sizes[s]);
+    }
+  }
+}
+
+
+/********************************************************************
+ *
+ *                        Memory footprint benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * Log the memory used per element by a list of items elements, in a child process
+ */
+template <class ListType, class Element>
+void runFootprint(const string &variant, int items)
+{
+  const string bench("footprint_compare");
+  const string name(variant + " bytes=" + to_string(sizeof(Element)) + " n=" + to_string(items));
+
+  bench_utils::runIsolated(bench, name, [&]() {
+    int64_t startKb(bench_utils::currentRssKb());
+    ListType sll;
+    for(int i = 0; i < items; ++i)
+    {
+      sll.append(Element(i));
+    }
+    bench_utils::logFootprint(bench, name, items, (bench_utils::currentRssKb() - startKb) * 1024);
+    bench_utils::doNotOptimize(sll.back());
+  });
+}
+
+template <class Element>
+void runFootprintCompare(int items)
+{
+  runFootprint<SimpleLinkedList<Element>, Element>("SimpleLinkedList HeapAllocator", items);
+  runFootprint<SimpleLinkedList<Element, PoolAllocator<Element> >, Element>("SimpleLinkedList PoolAllocator", items);
+  runFootprint<CompactLinkedList<Element>, Element>("CompactLinkedList", items);
+}
+
+void BENCH_footprint_compare()
+{
+  const int items(1000000);
+
+  runFootprintCompare<int>(items);
+  runFootprintCompare<Payload<8> >(items);
+  runFootprintCompare<Payload<16> >(items);
+  runFootprintCompare<Payload<32> >(items);
+  runFootprintCompare<Payload<64> >(items);
+}
+
+
+/********************************************************************
+ *
+ *                        Concurrent benchmarks
+ *
+ *******************************************************************/
+
+/*
+ * SimpleLinkedList protected by a mutex, the baseline for the concurrent list
+ */
+template <class T>
+class MutexLinkedList
+{
+public:
+  void append(const T &data)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    list_.append(data);
+  }
+
+  bool try_pop_front(T &data)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(list_.empty())
+    {
+      return false;
+    }
+    data = list_.front();
+    list_.pop_front();
+    return true;
+  }
+
+private:
+  std::mutex mutex_;
+  SimpleLinkedList<T> list_;
+};
+
+/*
+ * Run numPairs producers and numPairs consumers moving itemsPerProducer
+ * items each through the queue, return the elapsed time in ns
+ */
+template <class QueueType>
+double runProducersConsumers(QueueType &queue, int numPairs, int itemsPerProducer)
+{
+  std::atomic<int> consumed(0);
+  const int totalItems(numPairs * itemsPerProducer);
+  std::vector<std::thread> threads;
+
+  bench_utils::Timer timer;
+  for(int i = 0; i < numPairs; ++i)
+  {
+    threads.push_back(std::thread([&queue, itemsPerProducer]() {
+      for(int item = 0; item < itemsPerProducer; ++item)
+      {
+        queue.append(item);
+      }
+    }));
+    threads.push_back(std::thread([&queue, &consumed, totalItems]() {
+      int item;
+      while(consumed.load(std::memory_order_relaxed) < totalItems)
+      {
+        if(queue.try_pop_front(item))
+        {
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }));
+  }
+
+  for(size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+
+  return timer.elapsedNs();
+}
+
+void BENCH_concurrent_mpmcThroughput()
+{
+  const int itemsPerProducer(200000);
+  unsigned maxPairs(std::max(2u, std::thread::hardware_concurrency() / 2));
+
+  for(unsigned numPairs = 1; numPairs <= maxPairs; numPairs *= 2)
+  {
+    string threads(to_string(numPairs) + "P/" + to_string(numPairs) + "C");
+    uint64_t ops(uint64_t(numPairs) * itemsPerProducer);
+
+    ConcurrentLinkedList<int> lockFree;
+    bench_utils::logResult("concurrent_mpmcThroughput", "ConcurrentLinkedList " + threads, ops,
+                           runProducersConsumers(lockFree, numPairs, itemsPerProducer));
+
+    MutexLinkedList<int> locked;
+    bench_utils::logResult("concurrent_mpmcThroughput", "mutex+SimpleLinkedList " + threads, ops,
+                           runProducersConsumers(locked, numPairs, itemsPerProducer));
+  }
+}
+
+/*
+ * One producer appends timestamps, one consumer pops them and records
+ * the enqueue-to-dequeue latency of each item. The producer is paced at
+ * one item per intervalNs, so the latency isn't just the queueing delay.
+ */
+template <class QueueType>
+void runLatency(QueueType &queue, const string &variant, int items, int64_t intervalNs)
+{
+  vector<double> samples;
+  samples.reserve(items);
+
+  std::thread consumer([&queue, &samples, items]() {
+    int64_t stamp;
+    for(int i = 0; i < items; )
+    {
+      if(queue.try_pop_front(stamp))
+      {
+        samples.push_back(double(bench_utils::nowNs() - stamp));
+        ++i;
+      }
+    }
+  });
+
+  int64_t next(bench_utils::nowNs());
+  for(int i = 0; i < items; ++i)
+  {
+    int64_t now;
+    while((now = bench_utils::nowNs()) < next)
+    {
+    }
+    queue.append(now);
+    next += intervalNs;
+  }
+  consumer.join();
+
+  bench_utils::logLatency("spsc_latency", variant, samples);
+}
+
+void BENCH_spsc_latency()
+{
+  const int items(200000);
+  const int64_t intervalNs(500);
+
+  SpscLinkedList<int64_t> spsc;
+  runLatency(spsc, "SpscLinkedList", items, intervalNs);
+
+  ConcurrentLinkedList<int64_t> mpmc;
+  runLatency(mpmc, "ConcurrentLinkedList", items, intervalNs);
+
+  MutexLinkedList<int64_t> locked;
+  runLatency(locked, "mutex+SimpleLinkedList", items, intervalNs);
+}
+
+void BENCH_spsc_throughput()
+{
+  const int items(1000000);
+
+  SpscLinkedList<int> spsc;
+  bench_utils::logResult("spsc_throughput", "SpscLinkedList 1P/1C", items, runProducersConsumers(spsc, 1, items));
+
+  ConcurrentLinkedList<int> mpmc;
+  bench_utils::logResult("spsc_throughput", "ConcurrentLinkedList 1P/1C", items, runProducersConsumers(mpmc, 1, items));
+}
+
+
+void getBenches(bench_utils::BenchCaseList &benches)
+{
+  // Reversal benchmarks
+  ADD_BENCH(&BENCH_reverse_compare, benches);
+  ADD_BENCH(&BENCH_reverse_lazy, benches);
+
+  // Sort benchmarks
+  ADD_BENCH(&BENCH_sort_compare, benches);
+
+  // Traversal benchmarks
+  ADD_BENCH(&BENCH_traversal_prefetch, benches);
+
+  // SoA scan benchmarks
+  ADD_BENCH(&BENCH_soa_scans, benches);
+
+  // Parallel algorithm benchmarks
+  ADD_BENCH(&BENCH_parallel_scaling, benches);
+
+  // Compaction benchmarks
+  ADD_BENCH(&BENCH_compact_traversal, benches);
+
+  // Link policy benchmarks
+  ADD_BENCH(&BENCH_link_popBackDrain, benches);
+
+  // Copy benchmarks
+  ADD_BENCH(&BENCH_move_copyCount, benches);
+
+  // Stats benchmarks
+  ADD_BENCH(&BENCH_stats_overhead, benches);
+
+  // Error policy benchmarks
+  ADD_BENCH(&BENCH_errors_drain, benches);
+
+  // Bulk insertion benchmarks
+  ADD_BENCH(&BENCH_range_appendCompare, benches);
+
+  // Small list benchmarks
+  ADD_BENCH(&BENCH_small_lists, benches);
+
+  // Filter benchmarks
+  ADD_BENCH(&BENCH_filter_compare, benches);
+
+  // Startup benchmarks
+  ADD_BENCH(&BENCH_startup_mappedReload, benches);
+
+  // Stream benchmarks
+  ADD_BENCH(&BENCH_stream_throughput, benches);
+
+  // Intrusive list benchmarks
+  ADD_BENCH(&BENCH_intrusive_linkUnlink, benches);
+
+  // Container comparison benchmarks
+  ADD_BENCH(&BENCH_containers_compare, benches);
+
+  // Memory footprint benchmarks
+  ADD_BENCH(&BENCH_footprint_compare, benches);
+
+  // Concurrent benchmarks
+  ADD_BENCH(&BENCH_concurrent_mpmcThroughput, benches);
+  ADD_BENCH(&BENCH_spsc_latency, benches);
+  ADD_BENCH(&BENCH_spsc_throughput, benches);
+}
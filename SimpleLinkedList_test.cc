@@ -7,7 +7,28 @@
  *      Author: Brady Johnson
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include "SimpleLinkedList.hh"
+#include "ReversibleLinkedList.hh"
+#include "UnrolledLinkedList.hh"
+#include "CompactLinkedList.hh"
+#include "SoaLinkedList.hh"
+#include "MappedLinkedList.hh"
+#include "ListStream.hh"
+#include "IntrusiveLinkedList.hh"
+#include "ListAlgorithms.hh"
+#include "ConcurrentLinkedList.hh"
+#include "SpscLinkedList.hh"
 #include "TestUtils.hh"
 
 // Test class used as the object to be stored in the Linked List
@@ -18,8 +39,54 @@ struct TestNode
   int data_;
 };
 
+// Test class counting how many times it is constructed, copied, moved and destroyed
+struct CountedNode
+{
+  CountedNode(int data) : data_(data) { ++constructed; }
+  CountedNode(const CountedNode &other) : data_(other.data_) { ++copied; }
+  CountedNode(CountedNode &&other) : data_(other.data_) { ++moved; }
+  ~CountedNode() { ++destroyed; }
+  static void resetCounts() { constructed = copied = moved = destroyed = 0; }
+  int data_;
+  static int constructed;
+  static int copied;
+  static int moved;
+  static int destroyed;
+};
+int CountedNode::constructed(0);
+int CountedNode::copied(0);
+int CountedNode::moved(0);
+int CountedNode::destroyed(0);
+
+// Test class whose copy throws once copiesLeft copies have been made
+struct ThrowingNode
+{
+  ThrowingNode(int data) : data_(data) {}
+  ThrowingNode(const ThrowingNode &other) : data_(other.data_)
+  {
+    if(copiesLeft-- == 0)
+    {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  int data_;
+  static int copiesLeft;
+};
+int ThrowingNode::copiesLeft(0);
+
+typedef SimpleLinkedList<TestNode, PoolAllocator<TestNode, 16> > PoolList;
+typedef SimpleLinkedList<TestNode, HeapAllocator<TestNode>, DoublyLinked> DoublyList;
+typedef UnrolledLinkedList<TestNode, 4> UnrolledList;
+typedef SimpleLinkedList<TestNode, InlineAllocator<TestNode, 4> > InlineList;
+typedef CompactLinkedList<TestNode> CompactList;
+
+// Every member of the lists must compile, whatever the link policy
+template class SimpleLinkedList<int>;
+template class SimpleLinkedList<int, HeapAllocator<int>, DoublyLinked>;
+
 // Simple internal method to check the expected size and empty()
-bool checkSize(SimpleLinkedList<TestNode> &sll, uint32_t expectedSize)
+template <class ListType>
+bool checkSize(ListType &sll, uint32_t expectedSize)
 {
   if(sll.size() != expectedSize)
   {
@@ -271,290 +338,3018 @@ bool TEST_reset()
 
   return true;
 }
-
-/********************************************************************
- *
- *                        Accessor tests
- *
- *******************************************************************/
-
-bool TEST_front_empty()
+bool TEST_emplace_constructOnce()
 {
-  try
-  {
-    SimpleLinkedList<TestNode> sll;
-    TestNode tn = sll.front();
+  SimpleLinkedList<CountedNode> sll;
+  CountedNode::resetCounts();
 
-    // An exception should have been thrown
-    return false;
-  }
-  catch(std::length_error &e)
+  sll.emplace_back(1);
+  sll.emplace_front(0);
+  if(CountedNode::constructed != 2 || CountedNode::copied != 0 || CountedNode::moved != 0)
   {
-    // We're expecting this exception to be thrown
-    return true;
+    return false;
   }
+
+  return checkSize(sll, 2) && sll.front().data_ == 0 && sll.back().data_ == 1;
 }
 
-bool TEST_front_notEmpty()
+bool TEST_insertAppend_rvalue()
 {
-  SimpleLinkedList<TestNode> sll;
-  TestNode tn;
-  sll.insert(tn);
-
-  TestNode tn2 = sll.front();
+  SimpleLinkedList<CountedNode> sll;
+  CountedNode cn(1);
+  CountedNode::resetCounts();
+
+  // An lvalue is copied exactly once, an rvalue is moved exactly once
+  sll.append(cn);
+  sll.insert(cn);
+  if(CountedNode::copied != 2 || CountedNode::moved != 0)
+  {
+    return false;
+  }
 
-  // front() should affect the list at all
-  if(!checkSize(sll, 1))
+  sll.append(std::move(cn));
+  sll.insert(CountedNode(2));
+  if(CountedNode::copied != 2 || CountedNode::moved != 2)
   {
     return false;
   }
 
-  return true;
+  // front() and back() return references, no copies
+  sll.front().data_ = 3;
+  sll.back().data_ = 4;
+
+  return CountedNode::copied == 2 && sll.front().data_ == 3 && sll.back().data_ == 4;
 }
 
-bool TEST_back_empty()
+// Moving can't throw when the allocator copies share the nodes, so containers move the lists
+static_assert(std::is_nothrow_move_constructible<SimpleLinkedList<int> >::value, "heap list move may throw");
+static_assert(std::is_nothrow_move_assignable<SimpleLinkedList<int> >::value, "heap list move may throw");
+static_assert(std::is_nothrow_move_constructible<SimpleLinkedList<int, PoolAllocator<int> > >::value, "pool list move may throw");
+static_assert(!std::is_nothrow_move_constructible<SimpleLinkedList<int, InlineAllocator<int> > >::value, "inline list move allocates");
+
+bool TEST_move_list()
 {
-  try
+  SimpleLinkedList<TestNode> sll1;
+  for(int i = 0; i < 10; ++i)
   {
-    SimpleLinkedList<TestNode> sll;
-    TestNode tn = sll.back();
-
-    // An exception should have been thrown
-    return false;
+    sll1.append(TestNode(i));
   }
-  catch(std::length_error &e)
+
+  SimpleLinkedList<TestNode> sll2(std::move(sll1));
+  if(!checkSize(sll1, 0) || !checkSize(sll2, 10))
   {
-    // We're expecting this exception to be thrown
-    return true;
+    return false;
   }
-}
-
-bool TEST_back_notEmpty()
-{
-  SimpleLinkedList<TestNode> sll;
-  TestNode tn;
-  sll.insert(tn);
 
-  TestNode tn2 = sll.back();
-
-  // front() should affect the list at all
-  if(!checkSize(sll, 1))
+  SimpleLinkedList<TestNode> sll3;
+  sll3.append(TestNode(-1));
+  sll3 = std::move(sll2);
+  if(!checkSize(sll2, 0) || !checkSize(sll3, 10))
   {
     return false;
   }
 
-  return true;
-}
-
-
-/********************************************************************
- *
- *                        Iterator tests
- *
- *******************************************************************/
-
-bool TEST_begin_empty()
-{
-  try
+  int counter(0);
+  for(SimpleLinkedList<TestNode>::iterator iter = sll3.begin(); iter != sll3.end(); ++iter)
   {
-    SimpleLinkedList<TestNode> sll;
-    SimpleLinkedList<TestNode>::iterator iter = sll.begin();
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
 
-    // An exception should have been thrown
+  // The moved from list is still usable
+  sll1.append(TestNode(1));
+  if(counter != 10 || !checkSize(sll1, 1))
+  {
     return false;
   }
-  catch(std::length_error &e)
+
+  // A growing vector of lists moves them, the elements are never copied
+  CountedNode::resetCounts();
   {
-    // We're expecting this exception to be thrown
-    return true;
+    std::vector<SimpleLinkedList<CountedNode> > lists;
+    for(int i = 0; i < 20; ++i)
+    {
+      lists.push_back(SimpleLinkedList<CountedNode>());
+      lists.back().emplace_back(i);
+    }
   }
+
+  return CountedNode::constructed == 20 && CountedNode::copied == 0 && CountedNode::moved == 0;
 }
 
-bool TEST_begin_emptyConst()
+// Simple internal method to check the list holds first..last in order
+template <class ListType>
+bool checkRange(ListType &sll, int first, int last)
 {
-  try
+  if(!checkSize(sll, last < first ? 0 : last-first+1))
   {
-    SimpleLinkedList<TestNode> sll;
-    SimpleLinkedList<TestNode>::const_iterator iter = sll.begin();
-
-    // An exception should have been thrown
     return false;
   }
-  catch(std::length_error &e)
+
+  if(sll.empty())
   {
-    // We're expecting this exception to be thrown
     return true;
   }
+
+  int counter(first);
+  for(typename ListType::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  return counter == last+1 && sll.back().data_ == last;
 }
 
-bool TEST_beginEnd_notEmpty()
+// Simple internal method to check the list holds first..last in order, in both directions
+bool checkDoubly(DoublyList &dll, int first, int last)
 {
-  SimpleLinkedList<TestNode> sll;
-
-  int iterCount(10);
-  for(int i = 0; i < iterCount; ++i)
+  int counter(first);
+  if(!dll.empty())
   {
-    TestNode tn(i);
-    sll.append(tn);
+    for(DoublyList::iterator iter = dll.begin(); iter != dll.end(); ++iter)
+    {
+      if(iter->data_ != counter)
+      {
+        return false;
+      }
+      counter += (first <= last ? 1 : -1);
+    }
   }
 
-  int counter(0);
-  for(SimpleLinkedList<TestNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  for(DoublyList::reverse_iterator iter = dll.rbegin(); iter != dll.rend(); ++iter)
   {
-    // Check that it iterates the list in order
-    if(iter->data_ != counter++)
+    counter -= (first <= last ? 1 : -1);
+    if(iter->data_ != counter)
     {
       return false;
     }
   }
 
-  // Check that it iterated all the way through the list
-  if(counter != iterCount)
+  return counter == first;
+}
+
+/*
+ * Return true if the nodes of the list are laid out in list order, at a constant stride
+ */
+bool checkContiguous(PoolList &sll)
+{
+  PoolList::iterator iter(sll.begin());
+  char *prev(reinterpret_cast<char*>(&(*iter)));
+  ptrdiff_t stride(0);
+  for(iter.increment(); iter != sll.end(); iter.increment())
   {
-    return false;
+    char *current(reinterpret_cast<char*>(&(*iter)));
+    if(stride == 0)
+    {
+      stride = current - prev;
+    }
+    if(stride <= 0 || current - prev != stride)
+    {
+      return false;
+    }
+    prev = current;
   }
 
   return true;
 }
 
-bool TEST_beginEnd_notEmptyConst()
+bool TEST_splice()
 {
-  SimpleLinkedList<TestNode> sll;
-
-  int iterCount(10);
-  for(int i = 0; i < iterCount; ++i)
+  SimpleLinkedList<TestNode> sll1;
+  SimpleLinkedList<TestNode> sll2;
+  SimpleLinkedList<TestNode> sll3;
+  for(int i = 0; i < 5; ++i)
   {
-    TestNode tn(i);
-    sll.append(tn);
+    sll1.append(TestNode(i+5));
+    sll2.append(TestNode(i+10));
+    sll3.append(TestNode(i));
   }
 
-  int counter(0);
-  for(SimpleLinkedList<TestNode>::const_iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  sll1.splice_back(sll2);
+  sll1.splice_front(sll3);
+  if(!checkRange(sll1, 0, 14) || !checkSize(sll2, 0) || !checkSize(sll3, 0))
   {
-    // Check that it iterates the list in order
-    if(iter->data_ != counter++)
-    {
-      return false;
-    }
+    return false;
   }
 
-  // Check that it iterated all the way through the list
-  if(counter != iterCount)
+  // Splicing into and from empty lists
+  sll2.splice_back(sll1);
+  sll1.splice_front(sll2);
+  sll1.splice_back(sll3);
+  if(!checkRange(sll1, 0, 14) || !checkSize(sll2, 0))
   {
     return false;
   }
 
-  return true;
+  // The spliced list must still work at both ends
+  sll1.append(TestNode(15));
+  sll1.pop_back();
+  sll1.pop_front();
+
+  return checkRange(sll1, 1, 14);
 }
 
-bool TEST_end_empty()
+bool TEST_splice_doublyPool()
 {
-  try
+  typedef SimpleLinkedList<TestNode, PoolAllocator<TestNode, 4>, DoublyLinked> DoublyPoolList;
+  DoublyPoolList dll1;
+  DoublyPoolList dll2(dll1.get_allocator());
+  DoublyPoolList dll3;
+  for(int i = 0; i < 5; ++i)
   {
-    SimpleLinkedList<TestNode> sll;
-    SimpleLinkedList<TestNode>::iterator iter = sll.end();
+    dll1.append(TestNode(i+5));
+    dll2.append(TestNode(i+10));
+    dll3.append(TestNode(i));
+  }
 
-    // An exception should have been thrown
+  // dll2 shares the pool of dll1, dll3 has its own, so its elements are moved
+  dll1.splice_back(dll2);
+  dll1.splice_front(dll3);
+  if(!checkRange(dll1, 0, 14) || !checkSize(dll2, 0) || !checkSize(dll3, 0) ||
+     dll3.get_allocator().in_use() != 0 || dll1.get_allocator().in_use() != 15)
+  {
     return false;
   }
-  catch(std::length_error &e)
+
+  int counter(14);
+  for(DoublyPoolList::reverse_iterator iter = dll1.rbegin(); iter != dll1.rend(); ++iter)
   {
-    // We're expecting this exception to be thrown
-    return true;
+    if(iter->data_ != counter--)
+    {
+      return false;
+    }
   }
+
+  return counter == -1;
 }
 
-bool TEST_end_emptyConst()
+bool TEST_split()
 {
-  try
+  SimpleLinkedList<TestNode> sll;
+  for(int i = 0; i < 10; ++i)
   {
-    SimpleLinkedList<TestNode> sll;
-    SimpleLinkedList<TestNode>::const_iterator iter = sll.end();
+    sll.append(TestNode(i));
+  }
 
-    // An exception should have been thrown
+  SimpleLinkedList<TestNode> suffix(sll.split_at(6));
+  if(!checkRange(sll, 0, 5) || !checkRange(suffix, 6, 9))
+  {
     return false;
   }
-  catch(std::length_error &e)
+
+  SimpleLinkedList<TestNode>::iterator iter(sll.begin());
+  ++iter;
+  SimpleLinkedList<TestNode> middle(sll.split_after(iter));
+  if(!checkRange(sll, 0, 1) || !checkRange(middle, 2, 5))
   {
-    // We're expecting this exception to be thrown
-    return true;
+    return false;
   }
-}
-
-/********************************************************************
- *
- *                        Reversal tests
- *
- *******************************************************************/
 
-bool TEST_reverse_iterative_empty()
-{
-  try
+  // Nothing to split off after the tail, or past the size
+  SimpleLinkedList<TestNode>::iterator tailIter(middle.begin());
+  for(int i = 0; i < 3; ++i)
+  {
+    tailIter.increment();
+  }
+  SimpleLinkedList<TestNode> none1(middle.split_at(4));
+  SimpleLinkedList<TestNode> none2(middle.split_after(tailIter));
+  if(!checkSize(none1, 0) || !checkSize(none2, 0) || !checkRange(middle, 2, 5))
   {
-    SimpleLinkedList<TestNode> sll;
-    sll.reverseIterative();
-
-    // An exception should have been thrown
     return false;
   }
-  catch(std::length_error &e)
+
+  // Splitting at 0 takes the whole list
+  SimpleLinkedList<TestNode> all(suffix.split_at(0));
+  if(!checkSize(suffix, 0) || !checkRange(all, 6, 9))
   {
-    // We're expecting this exception to be thrown
-    return true;
+    return false;
   }
+
+  // Putting it all back together
+  sll.splice_back(middle);
+  sll.splice_back(all);
+  sll.append(TestNode(10));
+
+  return checkRange(sll, 0, 10);
 }
 
-bool TEST_reverse_iterative_NotEmpty()
+bool TEST_range_appendInsert()
 {
-  SimpleLinkedList<TestNode> sll;
+  std::vector<TestNode> elements;
+  for(int i = 3; i < 8; ++i)
+  {
+    elements.push_back(TestNode(i));
+  }
 
-  // do a reverse with just one node
-  TestNode tn0(0);
-  sll.append(tn0);
-  sll.reverseIterative();
-  if(!checkSize(sll, 1))
+  SimpleLinkedList<TestNode> sll{TestNode(0), TestNode(1), TestNode(2)};
+  sll.append_range(elements.begin(), elements.end());
+  if(!checkRange(sll, 0, 7))
   {
     return false;
   }
 
-  // Populate the list with 10 Nodes, 1-9 (the first was added above)
-  int iterCount(10);
-  for(int i = 1; i < iterCount; ++i)
+  // Inserted ranges keep their order, empty ranges change nothing
+  SimpleLinkedList<TestNode> other;
+  other.insert_range(elements.begin(), elements.end());
+  other.insert_range(elements.begin(), elements.begin());
+  other.insert_range(sll.begin(), std::next(sll.begin(), 3));
+  other.append_range(elements.end(), elements.end());
+  if(!checkRange(other, 0, 7))
   {
-    TestNode tn(i);
-    sll.append(tn);
+    return false;
   }
 
-  // reverse it, iteratively
-  sll.reverseIterative();
+  DoublyList dll{TestNode(2), TestNode(3)};
+  dll.insert_range(sll.begin(), std::next(sll.begin(), 2));
+  dll.append_range(elements.begin() + 1, elements.end());
 
-  // Now check that the nodes have been reversed
-  int counter(iterCount-1);
-  for(SimpleLinkedList<TestNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  return checkDoubly(dll, 0, 7);
+}
+
+bool TEST_iterator_stdAlgorithms()
+{
+  SimpleLinkedList<int> sll{1, 2, 3, 3, 4};
+
+  // Prefix ++ returns the incremented iterator, postfix ++ the previous one
+  SimpleLinkedList<int>::iterator iter(sll.begin());
+  if(*(++iter) != 2 || *(iter++) != 2 || *iter != 3)
   {
-    // Check that it iterates the list in order
-    if(iter->data_ != counter--)
-    {
-      return false;
-    }
+    return false;
   }
 
-  if(!checkSize(sll, iterCount))
+  // adjacent_find() and is_sorted() use the result of ++it
+  SimpleLinkedList<int>::iterator pair(std::adjacent_find(sll.begin(), sll.end()));
+  if(pair == sll.end() || *pair != 3 || *std::next(pair) != 3 || !std::is_sorted(sll.begin(), sll.end()))
   {
     return false;
   }
 
-  return true;
+  SimpleLinkedList<int> distinct{1, 2, 3};
+  return std::adjacent_find(distinct.begin(), distinct.end()) == distinct.end() &&
+         std::search_n(sll.begin(), sll.end(), 2, 3) == pair &&
+         std::count(sll.begin(), sll.end(), 3) == 2;
 }
 
-bool TEST_reverse_recursive_empty()
+bool TEST_range_poolContiguous()
 {
-  try
+  std::vector<TestNode> elements;
+  for(int i = 0; i < 100; ++i)
   {
-    SimpleLinkedList<TestNode> sll;
-    sll.reverseRecursive();
+    elements.push_back(TestNode(i));
+  }
 
-    // An exception should have been thrown
+  // More nodes than fit in one slab, they are still carved together
+  PoolList sll;
+  sll.append(TestNode(-1));
+  sll.append_range(elements.begin(), elements.end());
+  sll.pop_front();
+  if(!checkRange(sll, 0, 99) || sll.get_allocator().in_use() != 100)
+  {
+    return false;
+  }
+
+  // Consecutive elements are in consecutive nodes
+  if(!checkContiguous(sll))
+  {
+    return false;
+  }
+
+  // The nodes are allocated one at a time after the block, recycling the freed one first
+  sll.append(TestNode(100));
+  sll.append(TestNode(101));
+
+  return checkRange(sll, 0, 101) && sll.get_allocator().in_use() == 102;
+}
+
+bool TEST_range_throwing()
+{
+  ThrowingNode::copiesLeft = 100;
+  std::vector<ThrowingNode> elements;
+  for(int i = 0; i < 10; ++i)
+  {
+    elements.push_back(ThrowingNode(i));
+  }
+
+  SimpleLinkedList<ThrowingNode, PoolAllocator<ThrowingNode, 4> > sll;
+  sll.append(elements[0]);
+  try
+  {
+    // The 6th copy throws
+    ThrowingNode::copiesLeft = 5;
+    sll.append_range(elements.begin(), elements.end());
+    return false;
+  }
+  catch(std::runtime_error &e)
+  {
+  }
+
+  // The list is unchanged, and the nodes of the range are all back in the pool
+  ThrowingNode::copiesLeft = 100;
+  sll.append_range(elements.begin() + 1, elements.begin() + 3);
+
+  return checkSize(sll, 3) && sll.front().data_ == 0 && sll.back().data_ == 2 &&
+         sll.get_allocator().in_use() == 3;
+}
+
+bool TEST_copy_list()
+{
+  SimpleLinkedList<TestNode> sll1;
+  for(int i = 0; i < 10; ++i)
+  {
+    sll1.append(TestNode(i));
+  }
+
+  SimpleLinkedList<TestNode> sll2(sll1);
+  sll1.pop_front();
+  if(!checkRange(sll1, 1, 9) || !checkRange(sll2, 0, 9))
+  {
+    return false;
+  }
+
+  SimpleLinkedList<TestNode> sll3;
+  sll3.append(TestNode(-1));
+  sll3 = sll1;
+  sll3 = sll3;
+  sll1.reset();
+  if(!checkSize(sll1, 0) || !checkRange(sll3, 1, 9))
+  {
+    return false;
+  }
+
+  // Copying an empty list
+  sll3 = sll1;
+  SimpleLinkedList<TestNode> sll4(sll1);
+
+  return checkSize(sll3, 0) && checkSize(sll4, 0);
+}
+
+bool TEST_destructor_freesNodes()
+{
+  CountedNode::resetCounts();
+  {
+    SimpleLinkedList<CountedNode> sll;
+    for(int i = 0; i < 10; ++i)
+    {
+      sll.emplace_back(i);
+    }
+  }
+  if(CountedNode::destroyed != 10)
+  {
+    return false;
+  }
+
+  // The nodes of a list sharing a pool go back to it, those of a list with its own pool are released
+  PoolList owner;
+  owner.append(TestNode(0));
+  {
+    PoolList shared(owner.get_allocator());
+    PoolList alone;
+    for(int i = 0; i < 100; ++i)
+    {
+      shared.append(TestNode(i));
+      alone.append(TestNode(i));
+    }
+  }
+
+  return owner.get_allocator().in_use() == 1 && checkRange(owner, 0, 0);
+}
+
+bool TEST_insert_after()
+{
+  SimpleLinkedList<TestNode> sll{TestNode(0), TestNode(2), TestNode(4)};
+  SimpleLinkedList<TestNode>::iterator iter(sll.insert_after(sll.begin(), TestNode(1)));
+  if(iter->data_ != 1)
+  {
+    return false;
+  }
+
+  // Inserting after the tail moves the tail
+  iter = sll.insert_after(std::next(iter), TestNode(3));
+  iter = sll.insert_after(std::next(iter), TestNode(5));
+  sll.append(TestNode(6));
+  if(!checkRange(sll, 0, 6) || sll.back().data_ != 6)
+  {
+    return false;
+  }
+
+  try
+  {
+    sll.insert_after(sll.end(), TestNode(7));
+    return false;
+  }
+  catch(std::out_of_range &e)
+  {
+  }
+
+  DoublyList dll{TestNode(0), TestNode(3)};
+  dll.insert_after(dll.emplace_after(dll.begin(), 1), TestNode(2));
+  dll.emplace_after(std::next(dll.begin(), 3), 4);
+
+  return checkRange(sll, 0, 6) && checkDoubly(dll, 0, 4);
+}
+
+bool TEST_erase_after()
+{
+  SimpleLinkedList<TestNode> sll;
+  for(int i = 0; i < 6; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  // Erasing the tail moves the tail, and returns end()
+  SimpleLinkedList<TestNode>::iterator iter(sll.erase_after(std::next(sll.begin(), 4)));
+  if(iter != sll.end() || sll.back().data_ != 4)
+  {
+    return false;
+  }
+  sll.append(TestNode(5));
+  iter = sll.erase_after(sll.begin());
+  if(iter->data_ != 2 || sll.size() != 5)
+  {
+    return false;
+  }
+  sll.insert_after(sll.begin(), TestNode(1));
+  if(!checkRange(sll, 0, 5))
+  {
+    return false;
+  }
+
+  try
+  {
+    sll.erase_after(std::next(sll.begin(), 5));
+    return false;
+  }
+  catch(std::out_of_range &e)
+  {
+  }
+
+  DoublyList dll;
+  for(int i = 0; i < 6; ++i)
+  {
+    dll.append(TestNode(i));
+  }
+  dll.erase_after(dll.begin());
+  dll.erase_after(std::next(dll.begin(), 3));
+  dll.insert_after(dll.begin(), TestNode(1));
+  dll.pop_back();
+
+  return checkRange(sll, 0, 5) && checkDoubly(dll, 0, 3);
+}
+
+bool TEST_remove_if()
+{
+  SimpleLinkedList<TestNode> sll;
+  for(int i = 0; i < 20; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  // Removes the head, the tail and runs of nodes
+  uint32_t removed(sll.remove_if([](const TestNode &node) { return node.data_ < 3 || node.data_ > 9 || node.data_ == 6; }));
+  sll.insert_after(std::next(sll.begin(), 2), TestNode(6));
+  sll.append(TestNode(10));
+  if(removed != 14 || !checkRange(sll, 3, 10))
+  {
+    return false;
+  }
+
+  DoublyList dll;
+  for(int i = 0; i < 10; ++i)
+  {
+    dll.append(TestNode(i));
+  }
+  dll.remove_if([](const TestNode &node) { return node.data_ % 2 == 1; });
+  dll.remove_if([](const TestNode &node) { return node.data_ % 4 == 2; });
+  if(dll.size() != 3 || dll.back().data_ != 8 || dll.rbegin()->data_ != 8 ||
+     std::next(dll.rbegin(), 2)->data_ != 0)
+  {
+    return false;
+  }
+
+  SimpleLinkedList<int> ints{1, 2, 1, 1, 3, 1};
+  if(ints.remove(1) != 4 || ints.size() != 2 || ints.front() != 2 || ints.back() != 3)
+  {
+    return false;
+  }
+
+  // Removing everything empties the list
+  return ints.remove_if([](int) { return true; }) == 2 && checkSize(ints, 0) && ints.remove(1) == 0;
+}
+
+bool TEST_compact()
+{
+  // Inserted nodes are laid out backwards, the removed ones leave holes
+  PoolList sll;
+  for(int i = 0; i < 100; ++i)
+  {
+    sll.insert(TestNode(99 - i));
+    if(i % 3 == 0)
+    {
+      sll.insert(TestNode(-1));
+    }
+  }
+  sll.remove_if([](const TestNode &node) { return node.data_ < 0; });
+  if(!checkRange(sll, 0, 99) || checkContiguous(sll))
+  {
+    return false;
+  }
+
+  sll.compact();
+  if(!checkRange(sll, 0, 99) || !checkContiguous(sll) || sll.get_allocator().in_use() != 100)
+  {
+    return false;
+  }
+  sll.append(TestNode(100));
+
+  DoublyList dll;
+  for(int i = 0; i < 10; ++i)
+  {
+    dll.append(TestNode(i));
+  }
+  dll.compact();
+  dll.pop_back();
+
+  SimpleLinkedList<TestNode> empty;
+  empty.compact();
+
+  return checkRange(sll, 0, 100) && checkDoubly(dll, 0, 8) && checkSize(empty, 0);
+}
+
+bool TEST_compact_incremental()
+{
+  const uint32_t size(SimpleLinkedList<TestNode>::COMPACT_CHUNK_SIZE * 3 + 10);
+  DoublyList dll;
+  for(uint32_t i = 0; i < size; ++i)
+  {
+    dll.append(TestNode(i));
+  }
+
+  // Without any budget, one chunk is relocated per call
+  DoublyList::iterator position;
+  uint32_t calls(1);
+  while(!dll.compact_for(std::chrono::nanoseconds(0), position))
+  {
+    ++calls;
+  }
+  if(calls != 4 || position->data_ != int(size - 1) || !checkDoubly(dll, 0, size - 1))
+  {
+    return false;
+  }
+
+  // The list can change between calls, the nodes appended are compacted on the next call
+  dll.pop_front();
+  dll.append(TestNode(size));
+  dll.append(TestNode(size + 1));
+  if(!dll.compact_for(std::chrono::nanoseconds(0), position) || position->data_ != int(size + 1))
+  {
+    return false;
+  }
+
+  // Once compacted to the end there's nothing left to do, a large budget does everything at once
+  DoublyList::iterator restart;
+  if(!dll.compact_for(std::chrono::nanoseconds(0), position) ||
+     !dll.compact_for(std::chrono::seconds(10), restart))
+  {
+    return false;
+  }
+
+  return checkDoubly(dll, 1, size + 1);
+}
+
+bool TEST_compact_throwing()
+{
+  ThrowingNode::copiesLeft = 100;
+  SimpleLinkedList<ThrowingNode, PoolAllocator<ThrowingNode, 4> > sll;
+  for(int i = 0; i < 10; ++i)
+  {
+    sll.append(ThrowingNode(i));
+  }
+
+  // ThrowingNode can't be moved, so it's copied, and the 6th copy throws
+  ThrowingNode::copiesLeft = 5;
+  try
+  {
+    sll.compact();
+    return false;
+  }
+  catch(std::runtime_error &e)
+  {
+  }
+
+  // The list is unchanged, and the new nodes are all back in the pool
+  int counter(0);
+  for(SimpleLinkedList<ThrowingNode, PoolAllocator<ThrowingNode, 4> >::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+  {
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+  ThrowingNode::copiesLeft = 100;
+
+  return counter == 10 && sll.get_allocator().in_use() == 10;
+}
+
+/********************************************************************
+ *
+ *                        Accessor tests
+ *
+ *******************************************************************/
+
+bool TEST_front_empty()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    TestNode tn = sll.front();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_front_notEmpty()
+{
+  SimpleLinkedList<TestNode> sll;
+  TestNode tn;
+  sll.insert(tn);
+
+  TestNode tn2 = sll.front();
+
+  // front() should affect the list at all
+  if(!checkSize(sll, 1))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+bool TEST_back_empty()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    TestNode tn = sll.back();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_back_notEmpty()
+{
+  SimpleLinkedList<TestNode> sll;
+  TestNode tn;
+  sll.insert(tn);
+
+  TestNode tn2 = sll.back();
+
+  // front() should affect the list at all
+  if(!checkSize(sll, 1))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+
+/********************************************************************
+ *
+ *                        Iterator tests
+ *
+ *******************************************************************/
+
+bool TEST_begin_empty()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    SimpleLinkedList<TestNode>::iterator iter = sll.begin();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_begin_emptyConst()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    SimpleLinkedList<TestNode>::const_iterator iter = sll.begin();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_beginEnd_notEmpty()
+{
+  SimpleLinkedList<TestNode> sll;
+
+  int iterCount(10);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    TestNode tn(i);
+    sll.append(tn);
+  }
+
+  int counter(0);
+  for(SimpleLinkedList<TestNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    // Check that it iterates the list in order
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  // Check that it iterated all the way through the list
+  if(counter != iterCount)
+  {
+    return false;
+  }
+
+  return true;
+}
+
+bool TEST_beginEnd_notEmptyConst()
+{
+  SimpleLinkedList<TestNode> sll;
+
+  int iterCount(10);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    TestNode tn(i);
+    sll.append(tn);
+  }
+
+  int counter(0);
+  for(SimpleLinkedList<TestNode>::const_iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    // Check that it iterates the list in order
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  // Check that it iterated all the way through the list
+  if(counter != iterCount)
+  {
+    return false;
+  }
+
+  return true;
+}
+
+bool TEST_end_empty()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    SimpleLinkedList<TestNode>::iterator iter = sll.end();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_end_emptyConst()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    SimpleLinkedList<TestNode>::const_iterator iter = sll.end();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+/********************************************************************
+ *
+ *                        Reversal tests
+ *
+ *******************************************************************/
+
+bool TEST_reverse_iterative_empty()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    sll.reverseIterative();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_reverse_iterative_NotEmpty()
+{
+  SimpleLinkedList<TestNode> sll;
+
+  // do a reverse with just one node
+  TestNode tn0(0);
+  sll.append(tn0);
+  sll.reverseIterative();
+  if(!checkSize(sll, 1))
+  {
+    return false;
+  }
+
+  // Populate the list with 10 Nodes, 1-9 (the first was added above)
+  int iterCount(10);
+  for(int i = 1; i < iterCount; ++i)
+  {
+    TestNode tn(i);
+    sll.append(tn);
+  }
+
+  // reverse it, iteratively
+  sll.reverseIterative();
+
+  // Now check that the nodes have been reversed
+  int counter(iterCount-1);
+  for(SimpleLinkedList<TestNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    // Check that it iterates the list in order
+    if(iter->data_ != counter--)
+    {
+      return false;
+    }
+  }
+
+  if(!checkSize(sll, iterCount))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+// Simple internal method to check the list holds size elements counting down from size-1
+bool checkReversed(SimpleLinkedList<TestNode> &sll, int size)
+{
+  int counter(size-1);
+  for(SimpleLinkedList<TestNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    if(iter->data_ != counter--)
+    {
+      return false;
+    }
+  }
+
+  return counter == -1 && checkSize(sll, size) && sll.back().data_ == 0;
+}
+
+bool TEST_reverse_recursive_empty()
+{
+  try
+  {
+    SimpleLinkedList<TestNode> sll;
+    sll.reverseRecursive();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_reverse_recursive_NotEmpty()
+{
+  SimpleLinkedList<TestNode> sll;
+
+  // do a reverse with just one node
+  TestNode tn0(0);
+  sll.append(tn0);
+  sll.reverseIterative();
+  if(!checkSize(sll, 1))
+  {
+    return false;
+  }
+
+  if(!checkSize(sll, 1))
+  {
+    return false;
+  }
+
+  // Populate the list with 10 Nodes, 1-9 (the first was added above)
+  int iterCount(10);
+  for(int i = 1; i < iterCount; ++i)
+  {
+    TestNode tn(i);
+    sll.append(tn);
+  }
+
+  // reverse it, recursively
+  sll.reverseRecursive();
+
+  // Now check that the nodes have been reversed
+  int counter(iterCount-1);
+  for(SimpleLinkedList<TestNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    // Check that it iterates the list in order
+    if(iter->data_ != counter--)
+    {
+      return false;
+    }
+  }
+
+  if(!checkSize(sll, iterCount))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+/********************************************************************
+ *
+ *                        Doubly linked tests
+ *
+ *******************************************************************/
+
+bool TEST_doubly_pop_back()
+{
+  DoublyList dll;
+
+  int iterCount(10);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    dll.append(TestNode(i));
+  }
+  dll.insert(TestNode(-1));
+  dll.pop_front();
+
+  // Drain from the back
+  for(int i = iterCount-1; i >= 0; --i)
+  {
+    if(dll.back().data_ != i || !checkDoubly(dll, 0, i))
+    {
+      return false;
+    }
+    dll.pop_back();
+  }
+
+  if(!checkSize(dll, 0) || dll.rbegin() != dll.rend())
+  {
+    return false;
+  }
+
+  // Now that its empty, try to pop again
+  try
+  {
+    dll.pop_back();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_doubly_reverse()
+{
+  DoublyList dll;
+
+  int iterCount(10);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    dll.append(TestNode(i));
+  }
+
+  // The prev links must be reversed along with the next links
+  dll.reverseIterative();
+  if(!checkDoubly(dll, iterCount-1, 0))
+  {
+    return false;
+  }
+
+  dll.reverseRecursive();
+  if(!checkDoubly(dll, 0, iterCount-1))
+  {
+    return false;
+  }
+
+  dll.pop_back();
+  dll.pop_front();
+
+  return checkDoubly(dll, 1, iterCount-2) && checkSize(dll, iterCount-2);
+}
+
+/********************************************************************
+ *
+ *                        Reversible list tests
+ *
+ *******************************************************************/
+
+/*
+ * Check the elements of a list are first, first - 1, ..., last
+ */
+template <class ListType>
+bool checkDescending(ListType &list, int first, int last)
+{
+  int counter(first);
+  for(typename ListType::iterator iter = list.begin(); iter != list.end(); iter.increment())
+  {
+    if(iter->data_ != counter--)
+    {
+      return false;
+    }
+  }
+  return counter == last - 1 && list.size() == uint32_t(first - last + 1);
+}
+
+bool TEST_reversible_lazyEnds()
+{
+  ReversibleLinkedList<TestNode> rll;
+  try
+  {
+    rll.reverseIterative();
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+  }
+
+  for(int i = 0; i < 10; ++i)
+  {
+    rll.append(TestNode(i));
+  }
+
+  // The ends are swapped, the nodes aren't relinked
+  rll.reverseIterative();
+  if(!rll.reversed() || rll.front().data_ != 9 || rll.back().data_ != 0)
+  {
+    return false;
+  }
+  rll.pop_front();
+  rll.pop_back();
+  rll.insert(TestNode(9));
+  rll.append(TestNode(0));
+  if(!rll.reversed() || rll.front().data_ != 9 || rll.back().data_ != 0 || !checkSize(rll, 10))
+  {
+    return false;
+  }
+
+  // Reversing twice doesn't relink the nodes either
+  rll.reverseIterative();
+  rll.reverseIterative();
+  if(!rll.reversed())
+  {
+    return false;
+  }
+
+  // Iterating relinks them
+  if(!checkDescending(rll, 9, 0) || rll.reversed())
+  {
+    return false;
+  }
+  rll.reverseIterative();
+  if(!checkDoubly(rll.list(), 0, 9) || rll.reversed())
+  {
+    return false;
+  }
+
+  // A const list relinks its nodes too, but its underlying list can't be modified
+  static_assert(std::is_const<std::remove_reference<decltype(std::declval<const ReversibleLinkedList<TestNode> &>().list())>::type>::value,
+                "a const reversible list must not give access to a mutable list");
+  rll.reverseIterative();
+  const ReversibleLinkedList<TestNode> &constRll(rll);
+  int counter(9);
+  for(ReversibleLinkedList<TestNode>::const_iterator iter = constRll.begin(); iter != constRll.end(); iter.increment())
+  {
+    if(iter->data_ != counter--)
+    {
+      return false;
+    }
+  }
+  if(counter != -1 || constRll.reversed() || constRll.list().front().data_ != 9)
+  {
+    return false;
+  }
+
+  rll.reset();
+  return checkSize(rll, 0) && !rll.reversed();
+}
+
+bool TEST_reversible_sharedPool()
+{
+  typedef ReversibleLinkedList<TestNode, PoolAllocator<TestNode, 16>, SinglyLinked> ReversiblePoolList;
+  PoolList sll;
+  ReversiblePoolList rll1(sll.get_allocator());
+  ReversiblePoolList rll2(rll1.get_allocator());
+
+  // The three lists take their nodes from the same pool
+  sll.append(TestNode(0));
+  rll1.append(TestNode(1));
+  rll2.append(TestNode(2));
+  rll2.reverseIterative();
+  rll2.append(TestNode(3));
+
+  return sll.get_allocator().in_use() == 4 && rll1.get_allocator().in_use() == 4 &&
+         rll2.get_allocator().in_use() == 4 && rll2.front().data_ == 2 && rll2.back().data_ == 3;
+}
+
+bool TEST_reversible_singly()
+{
+  ReversibleLinkedList<TestNode, HeapAllocator<TestNode>, SinglyLinked> rll;
+  for(int i = 0; i < 10; ++i)
+  {
+    rll.append(TestNode(i));
+  }
+
+  // Popping the physical tail of a singly linked list relinks it first
+  rll.reverseIterative();
+  rll.pop_front();
+  if(rll.reversed() || !checkDescending(rll, 8, 0))
+  {
+    return false;
+  }
+
+  // Popping the physical head doesn't
+  rll.reverseIterative();
+  rll.pop_back();
+  if(!rll.reversed() || rll.back().data_ != 7 || rll.front().data_ != 0)
+  {
+    return false;
+  }
+
+  while(rll.size() > 1)
+  {
+    rll.pop_back();
+  }
+  rll.reverseIterative();
+
+  return checkRange(rll, 0, 0);
+}
+
+/********************************************************************
+ *
+ *                        Allocator tests
+ *
+ *******************************************************************/
+
+bool TEST_pool_appendInsertPop()
+{
+  PoolList sll;
+
+  // Use enough nodes to need several slabs
+  int iterCount(100);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+  sll.insert(TestNode(-1));
+  sll.pop_front();
+  sll.pop_back();
+
+  if(!checkSize(sll, iterCount-1))
+  {
+    return false;
+  }
+
+  int counter(0);
+  for(PoolList::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  return counter == iterCount-1 && sll.get_allocator().in_use() == uint32_t(iterCount-1);
+}
+
+bool TEST_pool_recycle()
+{
+  PoolList sll;
+  sll.append(TestNode(1));
+  TestNode *first(&(*sll.begin()));
+  sll.pop_front();
+
+  // The freed node should be reused for the next allocation
+  sll.append(TestNode(2));
+  TestNode *second(&(*sll.begin()));
+
+  return first == second && sll.front().data_ == 2;
+}
+
+bool TEST_pool_reset()
+{
+  PoolList sll;
+
+  // nothing should happen
+  sll.reset();
+
+  for(int i = 0; i < 100; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  sll.reset();
+  if(!checkSize(sll, 0) || sll.get_allocator().in_use() != 0)
+  {
+    return false;
+  }
+
+  // The list should be usable after a bulk reset
+  for(int i = 0; i < 100; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  return checkSize(sll, 100) && sll.back().data_ == 99;
+}
+
+bool TEST_pool_resetShared()
+{
+  PoolList sll1;
+  PoolList sll2(sll1.get_allocator());
+
+  for(int i = 0; i < 50; ++i)
+  {
+    sll1.append(TestNode(i));
+    sll2.append(TestNode(i));
+  }
+
+  // Resetting one list must not free the nodes of the other
+  sll1.reset();
+  if(!checkSize(sll1, 0) || sll1.get_allocator().in_use() != 50)
+  {
+    return false;
+  }
+
+  int counter(0);
+  for(PoolList::iterator iter = sll2.begin(); iter != sll2.end(); ++iter)
+  {
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  return counter == 50;
+}
+
+/*
+ * Return the number of elements of the list stored inside the list object
+ */
+int countInline(InlineList &sll)
+{
+  int count(0);
+  char *object(reinterpret_cast<char*>(&sll));
+  for(InlineList::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+  {
+    char *node(reinterpret_cast<char*>(&(*iter)));
+    if(node >= object && node < object + sizeof(sll))
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool TEST_inline_spill()
+{
+  InlineList sll;
+  for(int i = 1; i < 4; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+  sll.insert(TestNode(0));
+  if(!checkRange(sll, 0, 3) || countInline(sll) != 4)
+  {
+    return false;
+  }
+
+  // Beyond the inline nodes, the nodes are on the heap, and the freed inline nodes are reused first
+  sll.append(TestNode(4));
+  sll.append(TestNode(5));
+  if(!checkRange(sll, 0, 5) || countInline(sll) != 4)
+  {
+    return false;
+  }
+  sll.pop_front();
+  sll.insert(TestNode(0));
+  sll.pop_back();
+  sll.pop_back();
+  sll.append(TestNode(4));
+  if(!checkRange(sll, 0, 4) || countInline(sll) != 4)
+  {
+    return false;
+  }
+
+  sll.reverseIterative();
+  sll.sort([](const TestNode &lhs, const TestNode &rhs) { return lhs.data_ < rhs.data_; });
+
+  return checkRange(sll, 0, 4) && countInline(sll) == 4;
+}
+
+bool TEST_inline_moveCopySplit()
+{
+  InlineList sll;
+  for(int i = 0; i < 6; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  // The nodes can't leave the list object, the elements are moved into the nodes of the other list
+  InlineList moved(std::move(sll));
+  if(!checkSize(sll, 0) || !checkRange(moved, 0, 5) || countInline(moved) != 4)
+  {
+    return false;
+  }
+  sll = std::move(moved);
+  InlineList copied(sll);
+  copied = sll;
+  if(!checkSize(moved, 0) || !checkRange(sll, 0, 5) || !checkRange(copied, 0, 5) || countInline(copied) != 4)
+  {
+    return false;
+  }
+
+  InlineList suffix(sll.split_at(2));
+  InlineList all(suffix.split_at(0));
+  InlineList none(all.split_after(std::next(all.begin(), 3)));
+  if(!checkRange(sll, 0, 1) || !checkSize(suffix, 0) || !checkRange(all, 2, 5) || !checkSize(none, 0) ||
+     countInline(all) != 4)
+  {
+    return false;
+  }
+
+  sll.splice_back(all);
+  copied.reset();
+  std::vector<TestNode> elements(1, TestNode(6));
+  copied.insert_range(elements.begin(), elements.end());
+  copied.append_range(elements.begin(), elements.end());
+  copied.splice_front(sll);
+  copied.pop_back();
+  copied.pop_back();
+
+  return checkSize(sll, 0) && checkRange(copied, 0, 5);
+}
+
+/********************************************************************
+ *
+ *                        Error policy tests
+ *
+ *******************************************************************/
+
+bool TEST_tryPop_empty()
+{
+  SimpleLinkedList<TestNode> sll;
+  TestNode tn(7);
+  if(sll.try_pop_front(tn) || sll.try_pop_back(tn) || tn.data_ != 7 ||
+     sll.front_ptr() != NULL || sll.back_ptr() != NULL)
+  {
+    return false;
+  }
+
+  return checkSize(sll, 0);
+}
+
+bool TEST_tryPop_notEmpty()
+{
+  SimpleLinkedList<TestNode> sll;
+  for(int i = 0; i < 4; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  TestNode tn;
+  if(sll.front_ptr()->data_ != 0 || sll.back_ptr()->data_ != 3 ||
+     !sll.try_pop_front(tn) || tn.data_ != 0 || !sll.try_pop_back(tn) || tn.data_ != 3)
+  {
+    return false;
+  }
+
+  const SimpleLinkedList<TestNode> &constSll(sll);
+  return checkRange(sll, 1, 2) && constSll.front_ptr() == &sll.front() && constSll.back_ptr() == &sll.back();
+}
+
+bool TEST_noThrow_empty()
+{
+  typedef SimpleLinkedList<TestNode, HeapAllocator<TestNode>, SinglyLinked, NoStats, NoThrowOnEmpty> NoThrowList;
+  NoThrowList sll;
+
+  // Iterating and reversing an empty list does nothing
+  if(sll.begin() != sll.end())
+  {
+    return false;
+  }
+  for(NoThrowList::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    return false;
+  }
+  sll.reverseIterative();
+  sll.reverseRecursive();
+  sll.reverseParallel();
+
+  sll.append(TestNode(1));
+  sll.append(TestNode(2));
+  sll.pop_front();
+  sll.pop_back();
+  if(!checkSize(sll, 0) || sll.begin() != sll.end())
+  {
+    return false;
+  }
+
+  const NoThrowList &constSll(sll);
+  return constSll.begin() == constSll.end();
+}
+
+/********************************************************************
+ *
+ *                        Stats tests
+ *
+ *******************************************************************/
+
+bool TEST_stats_counting()
+{
+  typedef SimpleLinkedList<TestNode, HeapAllocator<TestNode>, SinglyLinked, CountingStats> StatsList;
+  StatsList sll;
+  for(int i = 0; i < 10; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+  sll.insert(TestNode(-1));
+
+  // Walks from the head to the penultimate node: 9 then 8 steps
+  sll.pop_back();
+  sll.pop_back();
+  sll.pop_front();
+
+  ListStatsSnapshot stats(sll.stats().snapshot());
+  if(stats.opCounts_[LIST_OP_APPEND] != 10 || stats.opCounts_[LIST_OP_INSERT] != 1 ||
+     stats.opCounts_[LIST_OP_POP_BACK] != 2 || stats.opCounts_[LIST_OP_POP_FRONT] != 1 ||
+     stats.popBackWalks_ != 2 || stats.popBackWalkSteps_ != 17 || stats.maxPopBackWalk_ != 9 ||
+     stats.nodesAllocated_ != 11 || stats.nodesFreed_ != 3)
+  {
+    return false;
+  }
+
+  if(stats.size_ != 8 || stats.peakSize_ != 11 || stats.bytesInUse_ == 0 ||
+     stats.peakBytesInUse_ != stats.bytesInUse_ / 8 * 11)
+  {
+    return false;
+  }
+
+  // Each operation is in exactly one latency bucket
+  uint64_t latencies(0);
+  for(uint32_t bucket = 0; bucket < ListStatsSnapshot::LATENCY_BUCKETS; ++bucket)
+  {
+    latencies += stats.latency_[LIST_OP_APPEND][bucket];
+  }
+
+  return latencies == 10;
+}
+
+bool TEST_stats_nestedAndEmpty()
+{
+  typedef SimpleLinkedList<TestNode, HeapAllocator<TestNode>, SinglyLinked, CountingStats> StatsList;
+  StatsList sll;
+  sll.append(TestNode(1));
+
+  // pop_back() of the only element is done with pop_front(), only the pop_back() is counted
+  sll.pop_back();
+  try
+  {
+    sll.front();
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+  }
+  try
+  {
+    sll.pop_front();
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+  }
+
+  std::vector<TestNode> elements(5, TestNode(2));
+  sll.append_range(elements.begin(), elements.end());
+  sll.reset();
+
+  ListStatsSnapshot stats(sll.stats().snapshot());
+  std::ostringstream dump;
+  sll.stats().dump(dump);
+
+  return stats.opCounts_[LIST_OP_POP_BACK] == 1 && stats.opCounts_[LIST_OP_POP_FRONT] == 1 &&
+         stats.opCounts_[LIST_OP_RANGE] == 1 && stats.opCounts_[LIST_OP_SPLICE] == 0 &&
+         stats.opCounts_[LIST_OP_RESET] == 1 && stats.emptyThrows_ == 2 &&
+         stats.nodesAllocated_ == 6 && stats.nodesFreed_ == 6 && stats.size_ == 0 &&
+         dump.str().find("pop_back: count=1") != std::string::npos;
+}
+
+/********************************************************************
+ *
+ *                        Algorithm tests
+ *
+ *******************************************************************/
+
+bool TEST_prefetch_forEach()
+{
+  SimpleLinkedList<TestNode> sll;
+  for(int i = 0; i < 100; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  // The elements are visited in order, with lookaheads shorter and longer than the list
+  const uint32_t distances[] = {0, 1, 8, 200};
+  for(size_t d = 0; d < sizeof(distances) / sizeof(distances[0]); ++d)
+  {
+    std::vector<int> visited;
+    prefetch_for_each(sll.begin(), sll.end(), [&visited](TestNode &node) { visited.push_back(node.data_); }, distances[d]);
+    if(visited.size() != 100 || !std::is_sorted(visited.begin(), visited.end()) || visited.back() != 99)
+    {
+      return false;
+    }
+  }
+
+  UnrolledList ull;
+  for(int i = 0; i < 10; ++i)
+  {
+    ull.append(TestNode(i));
+  }
+  int sum(0);
+  prefetch_for_each(ull.begin(), ull.end(), [&sum](TestNode &node) { sum += node.data_; });
+
+  return sum == 45;
+}
+
+bool TEST_jumpIndex_forEachReduce()
+{
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < 1000; ++i)
+  {
+    sll.append(i);
+  }
+
+  // Strides dividing the size or not, and longer than the list
+  const uint32_t strides[] = {1, 7, 100, 2000};
+  for(size_t s = 0; s < sizeof(strides) / sizeof(strides[0]); ++s)
+  {
+    JumpIndex<SimpleLinkedList<int>::iterator> index(sll.begin(), sll.end(), strides[s]);
+    if(index.size() != 1000 || index.segments() != (1000 + strides[s] - 1) / strides[s])
+    {
+      return false;
+    }
+
+    for(uint32_t lookahead = 0; lookahead < 10; lookahead += 3)
+    {
+      int expected(0);
+      bool ordered(true);
+      prefetch_for_each(index, [&expected, &ordered](int value) { ordered = ordered && value == expected++; }, lookahead);
+      if(!ordered || expected != 1000)
+      {
+        return false;
+      }
+
+      // The partial results are reduced in order, so a non commutative op works
+      int64_t sum(prefetch_reduce(index, int64_t(0), std::plus<int64_t>(), lookahead));
+      int64_t last(prefetch_reduce(index, int64_t(-1), [](int64_t, int64_t value) { return value; }, lookahead));
+      if(sum != 499500 || last != 999)
+      {
+        return false;
+      }
+    }
+  }
+
+  // An empty range has no segments
+  SimpleLinkedList<int>::iterator none;
+  JumpIndex<SimpleLinkedList<int>::iterator> index(none, none);
+  prefetch_for_each(index, [](int) {});
+
+  return index.segments() == 0 && prefetch_reduce(index, 3, std::plus<int>()) == 3;
+}
+
+bool TEST_parallel_algorithms()
+{
+  ThreadPool single(1);
+  ThreadPool pool(4);
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < 10007; ++i)
+  {
+    sll.append(i);
+  }
+
+  JumpIndex<SimpleLinkedList<int>::iterator> index(split_points(sll));
+  if(index.segments() != LIST_PARALLEL_TASKS || index.size() != 10007)
+  {
+    return false;
+  }
+
+  std::atomic<int64_t> sum(0);
+  parallel_for_each(index, [&sum](int value) { sum += value; }, pool);
+  parallel_transform(index, [](int value) { return value * 2; }, pool);
+  uint32_t even(parallel_count_if(index, [](int value) { return value % 4 == 0; }, pool));
+  int64_t total(parallel_reduce(index, int64_t(1), std::plus<int64_t>(), pool));
+  if(sum != 50065021 || even != 5004 || total != 100130043 || sll.back() != 20012)
+  {
+    return false;
+  }
+
+  // The floating point rounding doesn't depend on the number of threads
+  SimpleLinkedList<double> doubles;
+  for(int i = 0; i < 10000; ++i)
+  {
+    doubles.append(1.0 / (i + 1));
+  }
+  JumpIndex<SimpleLinkedList<double>::iterator> doubleIndex(split_points(doubles));
+  double singleSum(parallel_reduce(doubleIndex, 0.0, std::plus<double>(), single));
+  double poolSum(parallel_reduce(doubleIndex, 0.0, std::plus<double>(), pool));
+  if(singleSum != poolSum)
+  {
+    return false;
+  }
+
+  // Fewer elements than tasks, and no elements at all
+  SimpleLinkedList<int> small{1, 2, 3};
+  SimpleLinkedList<int> empty;
+  JumpIndex<SimpleLinkedList<int>::iterator> emptyIndex(split_points(empty));
+
+  return parallel_reduce(split_points(small), 0, std::plus<int>(), pool) == 6 &&
+         parallel_count_if(emptyIndex, [](int) { return true; }, pool) == 0 &&
+         parallel_reduce(emptyIndex, 5, std::plus<int>(), pool) == 5;
+}
+
+bool TEST_parallel_sharedPool()
+{
+  ThreadPool pool(4);
+
+  // A task running another parallel algorithm on the same pool
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < 1000; ++i)
+  {
+    sll.append(i);
+  }
+  JumpIndex<SimpleLinkedList<int>::iterator> index(split_points(sll));
+  std::atomic<int64_t> nested(0);
+  pool.run(4, [&](size_t) { nested += parallel_reduce(index, int64_t(0), std::plus<int64_t>(), pool); });
+  if(nested != 4 * 499500)
+  {
+    return false;
+  }
+
+  // Threads sorting unrelated lists at the same time, with the same pool
+  const int numThreads(4);
+  SimpleLinkedList<int> lists[numThreads];
+  for(int t = 0; t < numThreads; ++t)
+  {
+    for(int i = 0; i < 20000; ++i)
+    {
+      lists[t].append((i * 7919 + t) % 20000);
+    }
+  }
+  std::vector<std::thread> threads;
+  for(int t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread([&lists, &pool, t]() { lists[t].sortParallel(pool); }));
+  }
+  for(int t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+
+  for(int t = 0; t < numThreads; ++t)
+  {
+    int expected(0);
+    for(SimpleLinkedList<int>::iterator iter = lists[t].begin(); iter != lists[t].end(); iter++)
+    {
+      if(*iter != expected++)
+      {
+        return false;
+      }
+    }
+    if(expected != 20000)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ *
+ *                        Unrolled list tests
+ *
+ *******************************************************************/
+
+bool TEST_unrolled_empty()
+{
+  UnrolledList ull;
+  if(!checkSize(ull, 0))
+  {
+    return false;
+  }
+
+  try
+  {
+    ull.pop_front();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_unrolled_insertAppend()
+{
+  UnrolledList ull;
+
+  // Span several nodes in both directions: -1..-10 inserted, 0..9 appended
+  int iterCount(10);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    ull.append(TestNode(i));
+    ull.insert(TestNode(-i-1));
+  }
+
+  if(!checkSize(ull, iterCount*2) || ull.front().data_ != -iterCount || ull.back().data_ != iterCount-1)
+  {
+    return false;
+  }
+
+  int counter(-iterCount);
+  for(UnrolledList::iterator iter = ull.begin(); iter != ull.end(); ++iter)
+  {
+    // Check that it iterates the list in order
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  return counter == iterCount;
+}
+
+bool TEST_unrolled_popFrontBack()
+{
+  UnrolledList ull;
+
+  int iterCount(10);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    ull.append(TestNode(i));
+  }
+
+  // Drain from both ends, crossing node boundaries
+  for(int i = 0; i < iterCount/2; ++i)
+  {
+    if(ull.front().data_ != i || ull.back().data_ != iterCount-1-i)
+    {
+      return false;
+    }
+    ull.pop_front();
+    ull.pop_back();
+  }
+
+  if(!checkSize(ull, 0))
+  {
+    return false;
+  }
+
+  // The list should be usable once drained
+  ull.insert(TestNode(1));
+  ull.reset();
+
+  return checkSize(ull, 0);
+}
+
+/********************************************************************
+ *
+ *                        Compact list tests
+ *
+ *******************************************************************/
+
+bool TEST_compactList_empty()
+{
+  CompactList cll;
+  if(!checkSize(cll, 0) || cll.capacity() != 0 || CompactList::NODE_SIZE != 8)
+  {
+    return false;
+  }
+
+  try
+  {
+    cll.pop_back();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_compactList_insertAppendGrow()
+{
+  CompactList cll;
+  cll.append(TestNode(0));
+  CompactList::iterator first(cll.begin());
+
+  // The array grows several times, the iterators keep working
+  for(int i = 1; i < 100; ++i)
+  {
+    cll.append(TestNode(i));
+    cll.insert(TestNode(-i));
+  }
+  if(!checkSize(cll, 199) || first->data_ != 0 || cll.capacity() < 199)
+  {
+    return false;
+  }
+
+  int counter(-99);
+  for(CompactList::iterator iter = cll.begin(); iter != cll.end(); iter.increment())
+  {
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  return counter == 100 && cll.front().data_ == -99 && cll.back().data_ == 99;
+}
+
+bool TEST_compactList_popReuse()
+{
+  CompactList cll;
+  cll.reserve(10);
+  for(int i = 0; i < 10; ++i)
+  {
+    cll.append(TestNode(i));
+  }
+
+  // The freed nodes are reused, the array doesn't grow
+  for(int round = 0; round < 5; ++round)
+  {
+    cll.pop_front();
+    cll.pop_back();
+    cll.insert(TestNode(0));
+    cll.append(TestNode(9));
+  }
+  if(!checkRange(cll, 0, 9) || cll.capacity() != 10)
+  {
+    return false;
+  }
+
+  while(!cll.empty())
+  {
+    cll.pop_back();
+  }
+  cll.insert(TestNode(1));
+  cll.reset();
+  if(!checkSize(cll, 0) || cll.capacity() != 0)
+  {
+    return false;
+  }
+
+  // The elements are destroyed, and moved when the array grows
+  CountedNode::resetCounts();
+  {
+    CompactLinkedList<CountedNode> counted;
+    for(int i = 0; i < 20; ++i)
+    {
+      counted.emplace_back(i);
+    }
+  }
+
+  return CountedNode::constructed == 20 && CountedNode::destroyed == CountedNode::constructed + CountedNode::copied + CountedNode::moved;
+}
+
+bool TEST_compactList_growFromOwnElement()
+{
+  // Long strings, so that a copy from a freed array can't look right by chance
+  CompactLinkedList<string> cll;
+  cll.reserve(8);
+  for(int i = 0; i < 8; ++i)
+  {
+    cll.append(string(32, char('a' + i)));
+  }
+
+  // Full, the array grows while the new element is copied from one of its own
+  cll.append(cll.front());
+  if(cll.size() != 9 || cll.back() != string(32, 'a') || cll.front() != string(32, 'a'))
+  {
+    return false;
+  }
+  while(cll.size() < cll.capacity())
+  {
+    cll.append(string(32, 'z'));
+  }
+  cll.insert(cll.back());
+
+  return cll.size() == 17 && cll.front() == string(32, 'z') && cll.back() == string(32, 'z');
+}
+
+bool TEST_compactList_throwingGrow()
+{
+  ThrowingNode::copiesLeft = 100;
+  CompactLinkedList<ThrowingNode> cll;
+  for(int i = 0; i < 8; ++i)
+  {
+    cll.append(ThrowingNode(i));
+  }
+
+  // ThrowingNode can't be moved, growing copies it, and the 4th copy throws
+  ThrowingNode::copiesLeft = 3;
+  try
+  {
+    cll.append(ThrowingNode(8));
+    return false;
+  }
+  catch(std::runtime_error &e)
+  {
+  }
+  ThrowingNode::copiesLeft = 100;
+
+  int counter(0);
+  for(CompactLinkedList<ThrowingNode>::iterator iter = cll.begin(); iter != cll.end(); iter.increment())
+  {
+    if(iter->data_ != counter++)
+    {
+      return false;
+    }
+  }
+
+  return counter == 8 && cll.capacity() == 8;
+}
+
+/********************************************************************
+ *
+ *                        SoA list tests
+ *
+ *******************************************************************/
+
+/*
+ * Check the elements of a SoaLinkedList are first..last, following the links
+ */
+template <class T>
+bool checkSoaRange(SoaLinkedList<T> &sll, int first, int last)
+{
+  if(sll.size() != uint32_t(last - first + 1))
+  {
+    return false;
+  }
+
+  int counter(first);
+  for(typename SoaLinkedList<T>::iterator iter = sll.begin(); iter != sll.end(); iter.increment())
+  {
+    if(*iter != T(counter++))
+    {
+      return false;
+    }
+  }
+  return sll.front() == T(first) && sll.back() == T(last);
+}
+
+bool TEST_soaList_empty()
+{
+  SoaLinkedList<int> sll;
+  if(!sll.empty() || !sll.ordered() || sll.sum() != 0 || sll.count(0) != 0)
+  {
+    return false;
+  }
+
+  try
+  {
+    sll.min();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_soaList_physicalOrder()
+{
+  SoaLinkedList<int> sll;
+  for(int i = 0; i < 100; ++i)
+  {
+    sll.append(i);
+  }
+
+  // Popping from both ends, then inserting into the freed slots before the head, keeps the order
+  for(int i = 0; i < 10; ++i)
+  {
+    sll.pop_front();
+    sll.pop_back();
+  }
+  for(int i = 9; i >= 5; --i)
+  {
+    sll.insert(i);
+  }
+  if(!sll.ordered() || !checkSoaRange(sll, 5, 89))
+  {
+    return false;
+  }
+
+  // Appending moves the elements to the start of the arrays, or grows them
+  for(int i = 90; i < 1000; ++i)
+  {
+    sll.append(i);
+  }
+  if(!sll.ordered() || !checkSoaRange(sll, 5, 999))
+  {
+    return false;
+  }
+
+  // With no free slot before the head, inserting breaks the order
+  while(sll.front() != 0)
+  {
+    sll.insert(sll.front() - 1);
+  }
+  if(sll.ordered() || !checkSoaRange(sll, 0, 999))
+  {
+    return false;
+  }
+
+  // Out of order, the freed slots are reused
+  sll.pop_front();
+  sll.pop_back();
+  sll.insert(0);
+  sll.append(999);
+  sll.reorder();
+  if(!sll.ordered() || !checkSoaRange(sll, 0, 999))
+  {
+    return false;
+  }
+
+  // An empty list is in order again
+  sll.insert(-1);
+  while(!sll.empty())
+  {
+    sll.pop_back();
+  }
+  sll.append(1);
+  return sll.ordered() && checkSoaRange(sll, 1, 1);
+}
+
+/*
+ * Check the SIMD kernels against the scalar scans, on a list of n elements in physical
+ * order, then the same elements out of order. The elements are small so that the float sums are exact.
+ */
+template <class T>
+bool checkSoaKernels(uint32_t n)
+{
+  SoaLinkedList<T> ordered;
+  SoaLinkedList<T> unordered;
+  for(uint32_t i = 0; i < n; ++i)
+  {
+    ordered.append(T((i * 7) % 101));
+  }
+  for(uint32_t i = n; i > 0; --i)
+  {
+    unordered.insert(T(((i - 1) * 7) % 101));
+  }
+  if(n > 1 && (!ordered.ordered() || unordered.ordered()))
+  {
+    return false;
+  }
+
+  typename SoaLinkedList<T>::sum_type sum(0);
+  T min(T((0 * 7) % 101));
+  T max(min);
+  uint32_t count(0);
+  std::vector<T> values;
+  for(uint32_t i = 0; i < n; ++i)
+  {
+    T value(T((i * 7) % 101));
+    sum += value;
+    min = std::min(min, value);
+    max = std::max(max, value);
+    count += (value == T(42));
+    values.push_back(value);
+  }
+
+#if defined(SOA_SIMD)
+  // The lists use the AVX2 kernels when the CPU supports them, check the baseline ones too
+  if(n > 0 && (SoaKernels<T>::sum(&values[0], n) != sum || SoaKernels<T>::count(&values[0], n, T(42)) != count ||
+               SoaKernels<T>::template extremum<false>(&values[0], n) != min ||
+               SoaKernels<T>::template extremum<true>(&values[0], n) != max ||
+               SoaKernels<T>::find(&values[0], n, T(-1)) != n))
+  {
+    return false;
+  }
+#endif
+
+  SoaLinkedList<T> *lists[] = {&ordered, &unordered};
+  for(int l = 0; l < 2; ++l)
+  {
+    SoaLinkedList<T> &sll(*lists[l]);
+    if(sll.sum() != sum || sll.count(T(42)) != count || sll.count(T(-1)) != 0)
+    {
+      return false;
+    }
+    if(n == 0)
+    {
+      continue;
+    }
+    if(sll.min() != min || sll.max() != max)
+    {
+      return false;
+    }
+
+    // 42 is the element 6 from n = 7, then 49 and 56 are the elements 7 and 8
+    typename SoaLinkedList<T>::iterator found(sll.find(T(42)));
+    if((n > 6 && (found == sll.end() || *found != T(42))) || (n <= 6 && found != sll.end()))
+    {
+      return false;
+    }
+    if(n > 8 && *(++sll.find(T(49))) != T(56))
+    {
+      return false;
+    }
+    if(sll.find(T(-1)) != sll.end())
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool TEST_soaList_kernels()
+{
+  // Sizes around the vector widths, and long enough for the 8-bit counts to be added up several times
+  uint32_t sizes[] = {0, 1, 3, 7, 8, 31, 33, 100, 1000, 10001};
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    if(!checkSoaKernels<int>(sizes[s]) || !checkSoaKernels<float>(sizes[s]) ||
+       !checkSoaKernels<double>(sizes[s]) || !checkSoaKernels<int64_t>(sizes[s]) ||
+       !checkSoaKernels<uint8_t>(sizes[s]) || !checkSoaKernels<int16_t>(sizes[s]))
+    {
+      return false;
+    }
+  }
+
+  // The sums don't overflow the elements
+  SoaLinkedList<int> sll;
+  for(int i = 0; i < 100; ++i)
+  {
+    sll.append(2000000000);
+  }
+  return sll.sum() == int64_t(200000000000LL) && sll.max() == 2000000000;
+}
+
+/********************************************************************
+ *
+ *                        Mapped list tests
+ *
+ *******************************************************************/
+
+/*
+ * Return the path of a temporary file for the test, unique to the process
+ */
+string mappedPath(const string &name)
+{
+  return "/tmp/SimpleLinkedList_test_" + to_string(getpid()) + "_" + name + ".map";
+}
+
+bool TEST_mappedList_saveOpen()
+{
+  // More nodes than save() writes at once
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < 10000; ++i)
+  {
+    sll.append(i);
+  }
+  const string path(mappedPath("saveOpen"));
+  MappedLinkedList<int>::save(sll, path);
+
+  MappedLinkedList<int> mll(path);
+  std::remove(path.c_str());
+  if(mll.size() != 10000 || !mll.is_open() || mll.writable() || mll.front() != 0 || mll.back() != 9999)
+  {
+    return false;
+  }
+
+  int counter(0);
+  for(MappedLinkedList<int>::iterator iter = mll.begin(); iter != mll.end(); iter.increment())
+  {
+    if(*iter != counter++)
+    {
+      return false;
+    }
+  }
+  if(counter != 10000)
+  {
+    return false;
+  }
+
+  // Popping only moves the head of the mapped list
+  for(int i = 0; i < 9999; ++i)
+  {
+    mll.pop_front();
+  }
+  if(mll.size() != 1 || mll.front() != 9999 || mll.back() != 9999)
+  {
+    return false;
+  }
+  mll.pop_front();
+
+  // An empty list is saved too
+  sll.reset();
+  MappedLinkedList<int>::save(sll, path);
+  mll.open(path);
+  std::remove(path.c_str());
+  if(!mll.empty() || !mll.is_open())
+  {
+    return false;
+  }
+  mll.close();
+
+  try
+  {
+    mll.begin();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return !mll.is_open();
+  }
+}
+
+/*
+ * A list of 0..size-1 for save(), failing to read the element failAt
+ */
+struct FailingSaveList
+{
+  struct const_iterator
+  {
+    bool operator!=(const_iterator rhs) const { return rhs.index_ != index_; }
+    void increment() { ++index_; }
+    const int &operator*() const
+    {
+      if(index_ == failAt_)
+      {
+        throw std::runtime_error("can't read the element");
+      }
+      return index_;
+    }
+    int index_;
+    int failAt_;
+  };
+
+  uint32_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const_iterator begin() const { const_iterator iter = {0, failAt_}; return iter; }
+  const_iterator end() const { const_iterator iter = {int(size_), failAt_}; return iter; }
+
+  uint32_t size_;
+  int failAt_;
+};
+
+bool TEST_mappedList_replace()
+{
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < 1000; ++i)
+  {
+    sll.append(i);
+  }
+  const string path(mappedPath("replace"));
+  MappedLinkedList<int>::save(sll, path);
+  MappedLinkedList<int> previous(path);
+
+  // Saving over the mapped file doesn't change the mapped list
+  SimpleLinkedList<int> replacement{-1, -2, -3};
+  MappedLinkedList<int>::save(replacement, path);
+  MappedLinkedList<int> current(path);
+  if(current.size() != 3 || current.front() != -1 || current.back() != -3 ||
+     previous.size() != 1000 || previous.front() != 0 || previous.back() != 999)
+  {
+    std::remove(path.c_str());
+    return false;
+  }
+  int counter(0);
+  for(MappedLinkedList<int>::iterator iter = previous.begin(); iter != previous.end(); iter.increment())
+  {
+    if(*iter != counter++)
+    {
+      std::remove(path.c_str());
+      return false;
+    }
+  }
+
+  // A failed save leaves the previous file as it was
+  FailingSaveList failing = {100000, 90000};
+  try
+  {
+    MappedLinkedList<int>::save(failing, path);
+    std::remove(path.c_str());
+    return false;
+  }
+  catch(std::runtime_error &e)
+  {
+  }
+  MappedLinkedList<int> reopened(path);
+  std::remove(path.c_str());
+
+  return counter == 1000 && reopened.size() == 3 && reopened.front() == -1 && reopened.back() == -3;
+}
+
+/*
+ * An element with padding bytes
+ */
+struct MappedPoint
+{
+  char tag_;
+  double value_;
+};
+
+bool TEST_mappedList_copyOnWrite()
+{
+  SimpleLinkedList<MappedPoint> sll;
+  for(int i = 0; i < 100; ++i)
+  {
+    MappedPoint point = {char('a' + i % 26), i * 0.5};
+    sll.append(point);
+  }
+  const string path(mappedPath("copyOnWrite"));
+  MappedLinkedList<MappedPoint>::save(sll, path);
+
+  MappedLinkedList<MappedPoint> cow(path, LIST_MAP_COPY_ON_WRITE);
+  if(!cow.writable())
+  {
+    std::remove(path.c_str());
+    return false;
+  }
+  for(MappedLinkedList<MappedPoint>::iterator iter = cow.begin(); iter != cow.end(); iter.increment())
+  {
+    iter->value_ = -iter->value_;
+  }
+  cow.front().tag_ = 'z';
+
+  // The file isn't modified
+  MappedLinkedList<MappedPoint> readOnly(path);
+  std::remove(path.c_str());
+  int i(0);
+  MappedLinkedList<MappedPoint>::iterator modified(cow.begin());
+  for(MappedLinkedList<MappedPoint>::iterator iter = readOnly.begin(); iter != readOnly.end(); iter.increment(), modified.increment(), ++i)
+  {
+    if(iter->tag_ != char('a' + i % 26) || iter->value_ != i * 0.5 || modified->value_ != -i * 0.5)
+    {
+      return false;
+    }
+  }
+
+  return i == 100 && cow.front().tag_ == 'z' && readOnly.front().tag_ == 'a';
+}
+
+bool TEST_mappedList_errors()
+{
+  MappedLinkedList<int> mll;
+  try
+  {
+    mll.open(mappedPath("missing"));
+    return false;
+  }
+  catch(std::system_error &e)
+  {
+  }
+
+  // A list of another type, a file that isn't a list, and a truncated list
+  SimpleLinkedList<int> sll;
+  for(int i = 0; i < 10; ++i)
+  {
+    sll.append(i);
+  }
+  const string path(mappedPath("errors"));
+  MappedLinkedList<int>::save(sll, path);
+  bool otherType(false);
+  try
+  {
+    MappedLinkedList<double> mld(path);
+  }
+  catch(std::invalid_argument &e)
+  {
+    otherType = true;
+  }
+
+  bool truncated(false);
+  if(::truncate(path.c_str(), 64 + 5 * 16) == 0)
+  {
+    try
+    {
+      mll.open(path);
+    }
+    catch(std::invalid_argument &e)
+    {
+      truncated = true;
+    }
+  }
+
+  bool notList(false);
+  SimpleLinkedList<int> text;
+  MappedLinkedList<int>::save(text, path);
+  int fd(::open(path.c_str(), O_WRONLY));
+  if(fd >= 0 && ::write(fd, "not a list", 10) == 10)
+  {
+    try
+    {
+      mll.open(path);
+    }
+    catch(std::invalid_argument &e)
+    {
+      notList = true;
+    }
+  }
+  if(fd >= 0)
+  {
+    ::close(fd);
+  }
+  std::remove(path.c_str());
+
+  return otherType && truncated && notList && !mll.is_open();
+}
+
+/********************************************************************
+ *
+ *                        Stream tests
+ *
+ *******************************************************************/
+
+/*
+ * Return a descriptor of a new empty temporary file, already removed
+ */
+int streamFile(const string &name)
+{
+  const string path(mappedPath(name));
+  int fd(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600));
+  std::remove(path.c_str());
+  return fd;
+}
+
+/*
+ * Write text into fd, then rewind it
+ */
+void writeText(int fd, const string &text)
+{
+  listWriteAll(fd, text.data(), text.size(), "can't write the test file");
+  ::lseek(fd, 0, SEEK_SET);
+}
+
+bool TEST_stream_binaryRoundTrip()
+{
+  SimpleLinkedList<MappedPoint> points;
+  for(int i = 0; i < 1000; ++i)
+  {
+    MappedPoint point = {char('a' + i % 26), i * 0.25};
+    points.append(point);
+  }
+
+  // With the smallest buffers, the elements are split between the reads
+  int fd(streamFile("binary"));
+  {
+    ListStreamWriter<MappedPoint> writer(fd, LIST_STREAM_BINARY, 1);
+    writer.write_all(points);
+    writer.flush();
+    if(writer.bytes_written() != 16 + 1000 * sizeof(MappedPoint))
+    {
+      ::close(fd);
+      return false;
+    }
+  }
+  ::lseek(fd, 0, SEEK_SET);
+
+  SimpleLinkedList<MappedPoint, PoolAllocator<MappedPoint> > loaded;
+  ListStreamReader<MappedPoint> reader(fd, LIST_STREAM_BINARY, 1);
+  uint32_t reads(0);
+  while(!reader.eof())
+  {
+    reader.read_some(loaded);
+    ++reads;
+  }
+  ::close(fd);
+  if(loaded.size() != 1000 || reads < 10 || reader.bytes_read() != 16 + 1000 * sizeof(MappedPoint))
+  {
+    return false;
+  }
+
+  int i(0);
+  for(SimpleLinkedList<MappedPoint, PoolAllocator<MappedPoint> >::iterator iter = loaded.begin(); iter != loaded.end(); iter.increment(), ++i)
+  {
+    if(iter->tag_ != char('a' + i % 26) || iter->value_ != i * 0.25)
+    {
+      return false;
+    }
+  }
+
+  // An empty list is a stream of only the header, appended to an existing list
+  fd = streamFile("binaryEmpty");
+  {
+    ListStreamWriter<int> writer(fd);
+  }
+  ::lseek(fd, 0, SEEK_SET);
+  SimpleLinkedList<int> sll;
+  sll.append(1);
+  ListStreamReader<int> emptyReader(fd);
+  uint64_t count(emptyReader.read_all(sll));
+  ::close(fd);
+
+  return count == 0 && emptyReader.eof() && checkSize(sll, 1);
+}
+
+bool TEST_stream_textRoundTrip()
+{
+  SimpleLinkedList<int> ints;
+  int values[] = {0, -1, 1, 42, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+  for(int i = 0; i < 6; ++i)
+  {
+    ints.append(values[i]);
+  }
+  SimpleLinkedList<double> doubles;
+  double decimals[] = {0.1, -2.5e-300, 1e300, 3.0, -0.0, 1.0 / 3.0};
+  for(int i = 0; i < 6; ++i)
+  {
+    doubles.append(decimals[i]);
+  }
+
+  int fd(streamFile("text"));
+  {
+    ListStreamWriter<int> intWriter(fd, LIST_STREAM_TEXT, 1);
+    intWriter.write_all(ints);
+  }
+  int doubleFd(streamFile("textDouble"));
+  {
+    ListStreamWriter<double> doubleWriter(doubleFd, LIST_STREAM_TEXT, 1);
+    doubleWriter.write_all(doubles);
+  }
+  ::lseek(fd, 0, SEEK_SET);
+  ::lseek(doubleFd, 0, SEEK_SET);
+
+  SimpleLinkedList<int> intsLoaded;
+  ListStreamReader<int>(fd, LIST_STREAM_TEXT, 1).read_all(intsLoaded);
+  SimpleLinkedList<double> doublesLoaded;
+  ListStreamReader<double>(doubleFd, LIST_STREAM_TEXT, 1).read_all(doublesLoaded);
+  ::close(fd);
+  ::close(doubleFd);
+  if(!std::equal(ints.begin(), ints.end(), intsLoaded.begin()) || intsLoaded.size() != 6 ||
+     !std::equal(doubles.begin(), doubles.end(), doublesLoaded.begin()) || doublesLoaded.size() != 6)
+  {
+    return false;
+  }
+
+  // Any whitespace separates the elements, the last one needs none
+  fd = streamFile("textSpaces");
+  writeText(fd, "  1 2\t\t3\r\n+4\n\n255");
+  SimpleLinkedList<uint8_t> bytes;
+  ListStreamReader<uint8_t>(fd, LIST_STREAM_TEXT).read_all(bytes);
+  ::close(fd);
+
+  return bytes.size() == 5 && bytes.front() == 1 && bytes.back() == 255;
+}
+
+bool TEST_stream_pipe()
+{
+  int fds[2];
+  if(::pipe(fds) != 0)
+  {
+    return false;
+  }
+
+  // More than the pipe holds, the writer waits for the reader
+  const int items(100000);
+  std::thread writerThread([&fds, items]() {
+    SimpleLinkedList<int> sll;
+    for(int i = 0; i < items; ++i)
+    {
+      sll.append(i);
+    }
+    ListStreamWriter<int> writer(fds[1]);
+    writer.write_all(sll);
+    writer.flush();
+    ::close(fds[1]);
+  });
+
+  // The list is rebuilt as the bytes arrive
+  SimpleLinkedList<int> sll;
+  ListStreamReader<int> reader(fds[0]);
+  uint32_t batches(0);
+  while(!reader.eof())
+  {
+    if(reader.read_some(sll) > 0)
+    {
+      ++batches;
+    }
+  }
+  writerThread.join();
+  ::close(fds[0]);
+
+  return batches > 1 && checkSize(sll, items) && sll.front() == 0 && sll.back() == items - 1;
+}
+
+/*
+ * Return true if reading text as a list of T throws an std::invalid_argument exception
+ */
+template <class T>
+bool streamRejects(const string &text, ListStreamFormat format)
+{
+  int fd(streamFile("rejects"));
+  writeText(fd, text);
+  SimpleLinkedList<T> sll;
+  bool rejected(false);
+  try
+  {
+    ListStreamReader<T>(fd, format).read_all(sll);
+  }
+  catch(std::invalid_argument &e)
+  {
+    rejected = true;
+  }
+  ::close(fd);
+
+  return rejected;
+}
+
+bool TEST_stream_errors()
+{
+  try
+  {
+    ListStreamWriter<MappedPoint> writer(1, LIST_STREAM_TEXT);
+    return false;
+  }
+  catch(std::invalid_argument &e)
+  {
+  }
+
+  // A stream of ints, then the same truncated
+  int fd(streamFile("errors"));
+  {
+    ListStreamWriter<int> writer(fd);
+    writer.write(1);
+    writer.write(2);
+  }
+  string stream(24, '\0');
+  ::lseek(fd, 0, SEEK_SET);
+  bool readBack(::read(fd, &stream[0], stream.size()) == 24);
+  ::close(fd);
+
+  return readBack &&
+         !streamRejects<int>(stream, LIST_STREAM_BINARY) &&
+         streamRejects<double>(stream, LIST_STREAM_BINARY) &&
+         streamRejects<int>(stream.substr(0, 22), LIST_STREAM_BINARY) &&
+         streamRejects<int>(stream.substr(0, 10), LIST_STREAM_BINARY) &&
+         streamRejects<int>("", LIST_STREAM_BINARY) &&
+         streamRejects<int>("1 2 12a", LIST_STREAM_TEXT) &&
+         streamRejects<int>("- 1", LIST_STREAM_TEXT) &&
+         streamRejects<uint8_t>("256", LIST_STREAM_TEXT) &&
+         streamRejects<uint8_t>("-1", LIST_STREAM_TEXT) &&
+         streamRejects<int>(string(100, '1'), LIST_STREAM_TEXT) &&
+         streamRejects<double>("1.5.2", LIST_STREAM_TEXT);
+}
+
+/********************************************************************
+ *
+ *                        Intrusive list tests
+ *
+ *******************************************************************/
+
+// Test class that can be in two intrusive lists at once, with its base and member hooks
+struct HookedNode : public IntrusiveListHook
+{
+  HookedNode(int data) : data_(data) {}
+  int data_;
+  IntrusiveListHook memberHook_;
+};
+typedef IntrusiveLinkedList<HookedNode> BaseHookList;
+typedef IntrusiveLinkedList<HookedNode, MemberHook<HookedNode, &HookedNode::memberHook_> > MemberHookList;
+
+bool TEST_intrusive_linkUnlink()
+{
+  std::vector<HookedNode> nodes;
+  for(int i = 0; i < 10; ++i)
+  {
+    nodes.push_back(HookedNode(i));
+  }
+
+  BaseHookList sll;
+  for(int i = 5; i < 10; ++i)
+  {
+    sll.append(nodes[i]);
+  }
+  for(int i = 4; i >= 0; --i)
+  {
+    sll.insert(nodes[i]);
+  }
+
+  // The objects themselves are linked, not copies
+  int counter(0);
+  for(BaseHookList::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    if(&(*iter) != &nodes[counter++])
+    {
+      return false;
+    }
+  }
+  if(counter != 10 || !checkSize(sll, 10))
+  {
+    return false;
+  }
+
+  // O(1) removal from anywhere
+  sll.remove(nodes[5]);
+  sll.pop_front();
+  sll.pop_back();
+  if(sll.contains(nodes[5]) || nodes[5].is_linked() || !sll.contains(nodes[6]) ||
+     &sll.front() != &nodes[1] || &sll.back() != &nodes[8] || !checkSize(sll, 7))
+  {
+    return false;
+  }
+
+  sll.reverse();
+  if(&sll.front() != &nodes[8] || &sll.back() != &nodes[1])
+  {
+    return false;
+  }
+
+  // Unlinked objects can be linked again
+  sll.append(nodes[5]);
+  sll.reset();
+
+  return checkSize(sll, 0) && !nodes[1].is_linked() && !nodes[5].is_linked();
+}
+
+bool TEST_intrusive_twoLists()
+{
+  HookedNode node1(1);
+  HookedNode node2(2);
+  MemberHookList byMember;
+  {
+    BaseHookList byBase;
+    byBase.append(node1);
+    byBase.append(node2);
+    byMember.append(node2);
+    byMember.append(node1);
+
+    if(&byBase.front() != &node1 || &byMember.front() != &node2 ||
+       !byBase.contains(node1) || !byMember.contains(node1))
+    {
+      return false;
+    }
+  }
+
+  // The destroyed list unlinked its hooks, the other list is untouched
+  if(node1.is_linked() || node2.is_linked() || !byMember.contains(node1))
+  {
+    return false;
+  }
+
+  byMember.pop_front();
+
+  return &byMember.front() == &node1 && checkSize(byMember, 1);
+}
+
+bool TEST_intrusive_errors()
+{
+  HookedNode node(1);
+  BaseHookList sll1;
+  BaseHookList sll2;
+  sll1.append(node);
+
+  int errors(0);
+  try
+  {
+    // Each hook can only be in one list
+    sll2.append(node);
+  }
+  catch(std::invalid_argument &e)
+  {
+    ++errors;
+  }
+  try
+  {
+    sll2.remove(node);
+  }
+  catch(std::invalid_argument &e)
+  {
+    ++errors;
+  }
+  try
+  {
+    sll2.pop_back();
+  }
+  catch(std::length_error &e)
+  {
+    ++errors;
+  }
+
+  return errors == 3 && sll1.contains(node) && checkSize(sll2, 0);
+}
+
+/********************************************************************
+ *
+ *                        Concurrent list tests
+ *
+ *******************************************************************/
+
+bool TEST_concurrent_singleThread()
+{
+  ConcurrentLinkedList<TestNode> cll;
+  if(!cll.empty() || cll.size() != 0)
+  {
+    return false;
+  }
+
+  TestNode tn;
+  if(cll.try_pop_front(tn))
+  {
+    return false;
+  }
+
+  cll.append(TestNode(1));
+  cll.append(TestNode(2));
+  cll.append(TestNode(3));
+  if(cll.empty() || cll.size() != 3 || cll.front().data_ != 1)
+  {
+    return false;
+  }
+
+  cll.pop_front();
+  if(!cll.try_pop_front(tn) || tn.data_ != 2 || cll.front().data_ != 3)
+  {
+    return false;
+  }
+
+  cll.pop_front();
+  if(!cll.empty() || cll.size() != 0)
+  {
+    return false;
+  }
+
+  // Now that its empty, try to pop again
+  try
+  {
+    cll.pop_front();
+
+    // An exception should have been thrown
     return false;
   }
   catch(std::length_error &e)
@@ -564,52 +3359,339 @@ bool TEST_reverse_recursive_empty()
   }
 }
 
-bool TEST_reverse_recursive_NotEmpty()
+bool TEST_concurrent_mpmcStress()
+{
+  const int numProducers(4);
+  const int numConsumers(4);
+  const int itemsPerProducer(50000);
+  const int totalItems(numProducers * itemsPerProducer);
+
+  ConcurrentLinkedList<TestNode> cll;
+  std::atomic<int> consumed(0);
+  std::atomic<bool> sizeWrapped(false);
+  std::vector<std::vector<int> > received(numConsumers);
+  std::vector<std::thread> threads;
+
+  for(int p = 0; p < numProducers; ++p)
+  {
+    threads.push_back(std::thread([&cll, p, itemsPerProducer]() {
+      for(int i = 0; i < itemsPerProducer; ++i)
+      {
+        cll.append(TestNode(p * itemsPerProducer + i));
+      }
+    }));
+  }
+
+  for(int c = 0; c < numConsumers; ++c)
+  {
+    threads.push_back(std::thread([&cll, &consumed, &sizeWrapped, &received, c, totalItems]() {
+      TestNode tn;
+      while(consumed.load() < totalItems)
+      {
+        if(cll.try_pop_front(tn))
+        {
+          received[c].push_back(tn.data_);
+          consumed.fetch_add(1);
+        }
+        // The size is approximate, but never counts more than all the items
+        if(cll.size() > uint32_t(totalItems))
+        {
+          sizeWrapped = true;
+        }
+      }
+    }));
+  }
+
+  for(size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+
+  if(!cll.empty() || cll.size() != 0 || sizeWrapped)
+  {
+    return false;
+  }
+
+  // Every item must be received exactly once, and each consumer must
+  // receive the items of any one producer in the order they were appended
+  std::vector<bool> seen(totalItems, false);
+  for(int c = 0; c < numConsumers; ++c)
+  {
+    std::vector<int> last(numProducers, -1);
+    for(size_t i = 0; i < received[c].size(); ++i)
+    {
+      int item(received[c][i]);
+      if(item < 0 || item >= totalItems || seen[item] || item <= last[item / itemsPerProducer])
+      {
+        return false;
+      }
+      seen[item] = true;
+      last[item / itemsPerProducer] = item;
+    }
+  }
+
+  return consumed.load() == totalItems;
+}
+
+bool TEST_spsc_singleThread()
+{
+  SpscLinkedList<TestNode> spsc;
+  TestNode tn;
+  if(!spsc.empty() || spsc.size() != 0 || spsc.try_pop_front(tn))
+  {
+    return false;
+  }
+
+  // Enough rounds to recycle the consumed nodes several times
+  for(int i = 0; i < 100; ++i)
+  {
+    spsc.append(TestNode(i));
+    spsc.append(TestNode(i+1));
+    if(spsc.size() != 2 || spsc.front().data_ != i)
+    {
+      return false;
+    }
+
+    spsc.pop_front();
+    if(!spsc.try_pop_front(tn) || tn.data_ != i+1)
+    {
+      return false;
+    }
+  }
+
+  if(!spsc.empty() || spsc.size() != 0)
+  {
+    return false;
+  }
+
+  // Now that its empty, try to pop again
+  try
+  {
+    spsc.pop_front();
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
+  }
+}
+
+bool TEST_spsc_stress()
+{
+  const int items(200000);
+  SpscLinkedList<TestNode> spsc;
+  bool inOrder(true);
+  bool sizeWrapped(false);
+
+  std::thread consumer([&spsc, &inOrder, &sizeWrapped, items]() {
+    TestNode tn;
+    for(int expected = 0; expected < items; )
+    {
+      if(spsc.try_pop_front(tn))
+      {
+        inOrder = inOrder && (tn.data_ == expected++);
+      }
+      // The size is approximate, but never counts more than all the items
+      sizeWrapped = sizeWrapped || spsc.size() > uint32_t(items);
+    }
+  });
+
+  for(int i = 0; i < items; ++i)
+  {
+    spsc.append(TestNode(i));
+  }
+  consumer.join();
+
+  return inOrder && !sizeWrapped && spsc.empty() && spsc.size() == 0;
+}
+
+bool TEST_reverse_recursive_large()
+{
+  SimpleLinkedList<TestNode> sll;
+
+  // Deep enough to overflow the stack, if it recursed once per node
+  int iterCount(1000000);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    sll.append(TestNode(i));
+  }
+
+  sll.reverseRecursive();
+
+  return checkReversed(sll, iterCount);
+}
+
+bool TEST_reverse_parallel()
 {
+  ThreadPool pool(4);
   SimpleLinkedList<TestNode> sll;
 
   // do a reverse with just one node
-  TestNode tn0(0);
-  sll.append(tn0);
-  sll.reverseIterative();
-  if(!checkSize(sll, 1))
+  sll.append(TestNode(0));
+  sll.reverseParallel(pool);
+  if(!checkReversed(sll, 1))
   {
     return false;
   }
 
-  if(!checkSize(sll, 1))
+  // Large enough to be cut into segments, with a remainder for the last one
+  int iterCount(SimpleLinkedList<TestNode>::PARALLEL_REVERSE_MIN_SIZE + 3);
+  for(int i = 1; i < iterCount; ++i)
+  {
+    sll.insert(TestNode(i));
+  }
+
+  sll.reverseParallel(pool);
+  sll.reverseParallel(pool);
+  if(!checkReversed(sll, iterCount))
   {
     return false;
   }
 
-  // Populate the list with 10 Nodes, 1-9 (the first was added above)
-  int iterCount(10);
-  for(int i = 1; i < iterCount; ++i)
+  try
   {
-    TestNode tn(i);
-    sll.append(tn);
+    SimpleLinkedList<TestNode> emptyList;
+    emptyList.reverseParallel(pool);
+
+    // An exception should have been thrown
+    return false;
+  }
+  catch(std::length_error &e)
+  {
+    // We're expecting this exception to be thrown
+    return true;
   }
+}
 
-  // reverse it, recursively
-  sll.reverseRecursive();
+/********************************************************************
+ *
+ *                        Sort tests
+ *
+ *******************************************************************/
 
-  // Now check that the nodes have been reversed
-  int counter(iterCount-1);
-  for(SimpleLinkedList<TestNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+// Test class for stability: only key_ is compared, seq_ records the insertion order
+struct SortNode
+{
+  SortNode(int key, int seq) : key_(key), seq_(seq) {}
+  bool operator<(const SortNode &rhs) const { return key_ < rhs.key_; }
+  int key_;
+  int seq_;
+};
+
+// Simple internal method to check the list is sorted by key, stably, with the expected size
+template <class ListType>
+bool checkStableSort(ListType &sll, uint32_t expectedSize)
+{
+  if(sll.size() != expectedSize)
   {
-    // Check that it iterates the list in order
-    if(iter->data_ != counter--)
+    return false;
+  }
+
+  if(sll.empty())
+  {
+    return true;
+  }
+
+  uint32_t counter(0);
+  SortNode prev(sll.front());
+  for(typename ListType::iterator iter = sll.begin(); iter != sll.end(); ++iter, ++counter)
+  {
+    if(iter->key_ < prev.key_ || (iter->key_ == prev.key_ && iter->seq_ < prev.seq_))
     {
       return false;
     }
+    prev = *iter;
   }
 
-  if(!checkSize(sll, iterCount))
+  return counter == expectedSize && sll.back().key_ == prev.key_ && sll.back().seq_ == prev.seq_;
+}
+
+bool TEST_sort()
+{
+  SimpleLinkedList<SortNode> sll;
+
+  // nothing should happen
+  sll.sort();
+
+  sll.append(SortNode(1, 0));
+  sll.sort();
+  if(!checkStableSort(sll, 1))
   {
     return false;
   }
 
-  return true;
+  // Few distinct keys, so there are many equal elements to keep in order
+  srand(1);
+  int iterCount(1000);
+  for(int i = 1; i < iterCount; ++i)
+  {
+    sll.append(SortNode(rand() % 20, i));
+  }
+
+  sll.sort();
+  if(!checkStableSort(sll, iterCount))
+  {
+    return false;
+  }
+
+  // The list must still work at both ends after being relinked
+  sll.append(SortNode(100, iterCount));
+  sll.insert(SortNode(-1, -1));
+
+  return checkStableSort(sll, iterCount+2);
+}
+
+bool TEST_sort_comparator()
+{
+  DoublyList dll;
+
+  int iterCount(100);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    dll.append(TestNode((i * 37) % iterCount));
+  }
+
+  dll.sort([](const TestNode &lhs, const TestNode &rhs) { return lhs.data_ > rhs.data_; });
+
+  // Descending, and the prev links must match the new order
+  return checkDoubly(dll, iterCount-1, 0);
+}
+
+bool TEST_sort_parallel()
+{
+  ThreadPool pool(4);
+  SimpleLinkedList<SortNode> sll;
+
+  // Large enough to be cut into sublists, with a remainder for the last one
+  srand(2);
+  int iterCount(SimpleLinkedList<SortNode>::PARALLEL_SORT_MIN_SIZE + 3);
+  for(int i = 0; i < iterCount; ++i)
+  {
+    sll.append(SortNode(rand() % 100, i));
+  }
+
+  sll.sortParallel(pool);
+  if(!checkStableSort(sll, iterCount))
+  {
+    return false;
+  }
+
+  // Sorting a sorted list in reverse order
+  sll.sortParallel([](const SortNode &lhs, const SortNode &rhs) { return lhs.key_ > rhs.key_; }, pool);
+  int prevKey(sll.front().key_);
+  for(SimpleLinkedList<SortNode>::iterator iter = sll.begin(); iter != sll.end(); ++iter)
+  {
+    if(iter->key_ > prevKey)
+    {
+      return false;
+    }
+    prevKey = iter->key_;
+  }
+
+  return checkSize(sll, iterCount);
 }
 
 
@@ -627,8 +3709,26 @@ void getTests(test_utils::TestCaseList &tests)
   ADD_TEST(&TEST_pop_front_empty, tests);
   ADD_TEST(&TEST_pop_front_notEmpty, tests);
   ADD_TEST(&TEST_pop_back_empty, tests);
-  ADD_TEST(&TEST_pop_front_notEmpty, tests);
+  ADD_TEST(&TEST_pop_back_notEmpty, tests);
   ADD_TEST(&TEST_reset, tests);
+  ADD_TEST(&TEST_emplace_constructOnce, tests);
+  ADD_TEST(&TEST_insertAppend_rvalue, tests);
+  ADD_TEST(&TEST_move_list, tests);
+  ADD_TEST(&TEST_splice, tests);
+  ADD_TEST(&TEST_splice_doublyPool, tests);
+  ADD_TEST(&TEST_split, tests);
+  ADD_TEST(&TEST_range_appendInsert, tests);
+  ADD_TEST(&TEST_iterator_stdAlgorithms, tests);
+  ADD_TEST(&TEST_range_poolContiguous, tests);
+  ADD_TEST(&TEST_range_throwing, tests);
+  ADD_TEST(&TEST_copy_list, tests);
+  ADD_TEST(&TEST_destructor_freesNodes, tests);
+  ADD_TEST(&TEST_insert_after, tests);
+  ADD_TEST(&TEST_erase_after, tests);
+  ADD_TEST(&TEST_remove_if, tests);
+  ADD_TEST(&TEST_compact, tests);
+  ADD_TEST(&TEST_compact_incremental, tests);
+  ADD_TEST(&TEST_compact_throwing, tests);
 
   // Accessor tests
   ADD_TEST(&TEST_front_empty, tests);
@@ -649,4 +3749,83 @@ void getTests(test_utils::TestCaseList &tests)
   ADD_TEST(&TEST_reverse_iterative_NotEmpty, tests);
   ADD_TEST(&TEST_reverse_recursive_empty, tests);
   ADD_TEST(&TEST_reverse_recursive_NotEmpty, tests);
+  ADD_TEST(&TEST_reverse_recursive_large, tests);
+  ADD_TEST(&TEST_reverse_parallel, tests);
+
+  // Doubly linked Tests
+  ADD_TEST(&TEST_doubly_pop_back, tests);
+  ADD_TEST(&TEST_doubly_reverse, tests);
+
+  // Reversible list Tests
+  ADD_TEST(&TEST_reversible_lazyEnds, tests);
+  ADD_TEST(&TEST_reversible_singly, tests);
+  ADD_TEST(&TEST_reversible_sharedPool, tests);
+
+  // Sort Tests
+  ADD_TEST(&TEST_sort, tests);
+  ADD_TEST(&TEST_sort_comparator, tests);
+  ADD_TEST(&TEST_sort_parallel, tests);
+
+  // Allocator Tests
+  ADD_TEST(&TEST_pool_appendInsertPop, tests);
+  ADD_TEST(&TEST_pool_recycle, tests);
+  ADD_TEST(&TEST_pool_reset, tests);
+  ADD_TEST(&TEST_pool_resetShared, tests);
+  ADD_TEST(&TEST_inline_spill, tests);
+  ADD_TEST(&TEST_inline_moveCopySplit, tests);
+
+  // Error policy Tests
+  ADD_TEST(&TEST_tryPop_empty, tests);
+  ADD_TEST(&TEST_tryPop_notEmpty, tests);
+  ADD_TEST(&TEST_noThrow_empty, tests);
+
+  // Stats Tests
+  ADD_TEST(&TEST_stats_counting, tests);
+  ADD_TEST(&TEST_stats_nestedAndEmpty, tests);
+
+  // Algorithm Tests
+  ADD_TEST(&TEST_prefetch_forEach, tests);
+  ADD_TEST(&TEST_jumpIndex_forEachReduce, tests);
+  ADD_TEST(&TEST_parallel_algorithms, tests);
+  ADD_TEST(&TEST_parallel_sharedPool, tests);
+
+  // Unrolled list Tests
+  ADD_TEST(&TEST_unrolled_empty, tests);
+  ADD_TEST(&TEST_unrolled_insertAppend, tests);
+  ADD_TEST(&TEST_unrolled_popFrontBack, tests);
+
+  // Compact list Tests
+  ADD_TEST(&TEST_compactList_empty, tests);
+  ADD_TEST(&TEST_compactList_insertAppendGrow, tests);
+  ADD_TEST(&TEST_compactList_popReuse, tests);
+  ADD_TEST(&TEST_compactList_growFromOwnElement, tests);
+  ADD_TEST(&TEST_compactList_throwingGrow, tests);
+
+  // SoA list Tests
+  ADD_TEST(&TEST_soaList_empty, tests);
+  ADD_TEST(&TEST_soaList_physicalOrder, tests);
+  ADD_TEST(&TEST_soaList_kernels, tests);
+
+  // Mapped list Tests
+  ADD_TEST(&TEST_mappedList_saveOpen, tests);
+  ADD_TEST(&TEST_mappedList_replace, tests);
+  ADD_TEST(&TEST_mappedList_copyOnWrite, tests);
+  ADD_TEST(&TEST_mappedList_errors, tests);
+
+  // Stream Tests
+  ADD_TEST(&TEST_stream_binaryRoundTrip, tests);
+  ADD_TEST(&TEST_stream_textRoundTrip, tests);
+  ADD_TEST(&TEST_stream_pipe, tests);
+  ADD_TEST(&TEST_stream_errors, tests);
+
+  // Intrusive list Tests
+  ADD_TEST(&TEST_intrusive_linkUnlink, tests);
+  ADD_TEST(&TEST_intrusive_twoLists, tests);
+  ADD_TEST(&TEST_intrusive_errors, tests);
+
+  // Concurrent list Tests
+  ADD_TEST(&TEST_concurrent_singleThread, tests);
+  ADD_TEST(&TEST_concurrent_mpmcStress, tests);
+  ADD_TEST(&TEST_spsc_singleThread, tests);
+  ADD_TEST(&TEST_spsc_stress, tests);
 }
@@ -0,0 +1,726 @@
+/*
+ * SoaLinkedList.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SOALINKEDLIST_HH_
+#define SOALINKEDLIST_HH_
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <stdint.h>
+
+#include "ListPolicies.hh"
+
+/*
+ * The scans over contiguous elements are written with the GCC vector
+ * extensions, and compiled twice: for the baseline instruction set, which
+ * is SSE2 on x86-64, and for AVX2, used when the CPU supports it.
+ * Other compilers only get the scalar scans following the links.
+ */
+#if defined(__GNUC__)
+#define SOA_SIMD 1
+#define SOA_ALWAYS_INLINE inline __attribute__((always_inline))
+#if defined(__x86_64__) || defined(__i386__)
+#define SOA_AVX2 1
+#endif
+#endif
+
+/**
+ * The type of the sums of elements of type T: 64-bit integers or double
+ */
+template <class T>
+struct SoaSumType
+{
+  typedef typename std::conditional<std::is_floating_point<T>::value, double,
+            typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>::type type;
+};
+
+#if defined(SOA_SIMD)
+
+/**
+ * The SIMD kernels over an array of n elements. They're always inlined,
+ * so they're compiled with the instruction set of the function calling them.
+ */
+template <class T>
+struct SoaKernels
+{
+  typedef typename SoaSumType<T>::type Sum;
+
+  static const std::size_t LANES = 32 / sizeof(T);
+  static const std::size_t SUM_LANES = 32 / sizeof(Sum);
+  typedef T Vector __attribute__((vector_size(32)));
+  typedef Sum SumVector __attribute__((vector_size(32)));
+
+  // The elements converted into one SumVector
+  typedef T SumSource __attribute__((vector_size(SUM_LANES * sizeof(T))));
+
+  /*
+   * Vectors are never passed by value, their ABI depends on the instruction set
+   */
+  static SOA_ALWAYS_INLINE void load(Vector &vector, const T *values)
+  {
+    std::memcpy(&vector, values, sizeof(vector));
+  }
+
+  static SOA_ALWAYS_INLINE Sum sum(const T *values, uint32_t n)
+  {
+    SumVector acc = {};
+    uint32_t i(0);
+    for(; i + SUM_LANES <= n; i += SUM_LANES)
+    {
+      SumSource source;
+      std::memcpy(&source, values + i, sizeof(source));
+      acc += __builtin_convertvector(source, SumVector);
+    }
+
+    Sum total(0);
+    for(std::size_t lane = 0; lane < SUM_LANES; ++lane)
+    {
+      total += acc[lane];
+    }
+    for(; i < n; ++i)
+    {
+      total += values[i];
+    }
+    return total;
+  }
+
+  /**
+   * Return the smallest element if Max is false, else the largest, n must not be 0
+   */
+  template <bool Max>
+  static SOA_ALWAYS_INLINE T extremum(const T *values, uint32_t n)
+  {
+    T result(values[0]);
+    uint32_t i(0);
+    if(n >= LANES)
+    {
+      Vector acc;
+      load(acc, values);
+      for(i = LANES; i + LANES <= n; i += LANES)
+      {
+        Vector vector;
+        load(vector, values + i);
+        acc = (Max ? vector > acc : vector < acc) ? vector : acc;
+      }
+      for(std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        result = (Max ? acc[lane] > result : acc[lane] < result) ? acc[lane] : result;
+      }
+    }
+    for(; i < n; ++i)
+    {
+      result = (Max ? values[i] > result : values[i] < result) ? values[i] : result;
+    }
+    return result;
+  }
+
+  static SOA_ALWAYS_INLINE uint32_t count(const T *values, uint32_t n, T value)
+  {
+    typedef decltype(Vector() == Vector()) Mask;
+    Vector splat(Vector() + value);
+    uint32_t total(0);
+    uint32_t i(0);
+    while(i + LANES <= n)
+    {
+      // Each lane counts to at most 127 before being added up, for the 8-bit elements
+      Mask counts = {};
+      for(uint32_t block = 0; block < 127 && i + LANES <= n; ++block, i += LANES)
+      {
+        Vector vector;
+        load(vector, values + i);
+        counts -= (vector == splat);
+      }
+      for(std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        total += uint32_t(counts[lane]);
+      }
+    }
+    for(; i < n; ++i)
+    {
+      total += (values[i] == value);
+    }
+    return total;
+  }
+
+  /**
+   * Return the index of the first element equal to value, or n if there's none
+   */
+  static SOA_ALWAYS_INLINE uint32_t find(const T *values, uint32_t n, T value)
+  {
+    Vector splat(Vector() + value);
+    uint32_t i(0);
+    for(; i + LANES <= n; i += LANES)
+    {
+      Vector vector;
+      load(vector, values + i);
+      uint64_t words[4];
+      auto mask(vector == splat);
+      std::memcpy(words, &mask, sizeof(words));
+      if((words[0] | words[1] | words[2] | words[3]) != 0)
+      {
+        break;
+      }
+    }
+    for(; i < n; ++i)
+    {
+      if(values[i] == value)
+      {
+        return i;
+      }
+    }
+    return n;
+  }
+};
+
+#if defined(SOA_AVX2)
+
+/**
+ * The AVX2 builds of the kernels, only called when the CPU supports AVX2
+ */
+template <class T>
+struct SoaKernelsAvx2
+{
+  typedef SoaKernels<T> Kernels;
+  typedef typename Kernels::Sum Sum;
+
+  __attribute__((target("avx2"))) static Sum sum(const T *values, uint32_t n) { return Kernels::sum(values, n); }
+  __attribute__((target("avx2"))) static T min(const T *values, uint32_t n) { return Kernels::template extremum<false>(values, n); }
+  __attribute__((target("avx2"))) static T max(const T *values, uint32_t n) { return Kernels::template extremum<true>(values, n); }
+  __attribute__((target("avx2"))) static uint32_t count(const T *values, uint32_t n, T value) { return Kernels::count(values, n, value); }
+  __attribute__((target("avx2"))) static uint32_t find(const T *values, uint32_t n, T value) { return Kernels::find(values, n, value); }
+};
+
+inline bool soaHasAvx2()
+{
+  static const bool hasAvx2(__builtin_cpu_supports("avx2"));
+  return hasAvx2;
+}
+
+#endif
+#endif
+
+/**
+ * A single LinkedList of numbers, stored as a struct of arrays: the elements
+ * in one contiguous array, and the links, 32-bit indices, in another one.
+ * insert(), append() and pop_front() are O(1), like in the SimpleLinkedList.
+ * While the list is in physical order, meaning the elements are stored in
+ * list order, the scans (sum(), min(), max(), count(), find()) run SIMD
+ * kernels over the element array, and pop_back() is O(1) too. The list
+ * stays in physical order as long as it's only appended to and popped from,
+ * but inserting when there's no free slot before the head breaks the order:
+ * the scans then follow the links, until reorder() is called.
+ * Growing the arrays or reordering invalidates the iterators.
+ */
+template <class T>
+class SoaLinkedList
+{
+private:
+  static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, "the elements must be numbers");
+
+  /**
+   * The index used as a NULL link
+   */
+  static const uint32_t NIL = 0xFFFFFFFF;
+
+  /**
+   * Internal class used to iterate the Linked List
+   */
+  class ListIterator
+  {
+  public:
+    ListIterator() : list_(NULL), index_(NIL) {}
+    ListIterator(SoaLinkedList *list, uint32_t index) : list_(list), index_(index) {}
+    bool operator==(ListIterator rhs) const { return rhs.index_ == index_; }
+    bool operator!=(ListIterator rhs) const { return rhs.index_ != index_; }
+    T * operator->() const { return list_->values_ + index_; }
+    T & operator*() const { return list_->values_[index_]; }
+    void increment() { index_ = list_->next_[index_]; }
+    ListIterator &operator++() { increment(); return *this; }
+    ListIterator operator++(int unused) { ListIterator retval(*this); increment(); return retval; }
+  private:
+    SoaLinkedList *list_;
+    uint32_t index_;
+  };
+
+public:
+  typedef ListIterator iterator;
+  typedef ListIterator const_iterator;
+  typedef typename SoaSumType<T>::type sum_type;
+
+  SoaLinkedList() :
+    values_(NULL),
+    next_(NULL),
+    capacity_(0),
+    carved_(0),
+    freeList_(NIL),
+    head_(0),
+    tail_(NIL),
+    size_(0),
+    ordered_(true)
+  {
+  }
+
+  ~SoaLinkedList()
+  {
+    reset();
+  }
+
+  /**
+   * Return an iterator to the beginning of the Linked List.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator begin() { emptyException(); return ListIterator(this, head_); }
+  const_iterator begin() const { emptyException(); return ListIterator(const_cast<SoaLinkedList*>(this), head_); }
+
+  /**
+   * Return an iterator indicating the end of the Linked List has been reached
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator end() { emptyException(); return ListIterator(); }
+  const_iterator end() const { emptyException(); return ListIterator(); }
+
+  /**
+   * Return the number of elements in the linked list
+   */
+  inline uint32_t size() const { return size_; }
+
+  /**
+   * Return true if the list is empty, false otherwise
+   */
+  inline bool empty() const { return size_ == 0; }
+
+  /**
+   * Return true if the elements are stored in list order, so the scans run SIMD kernels
+   */
+  inline bool ordered() const { return ordered_; }
+
+  /**
+   * Insert a data element into the head of the Linked List.
+   * The list stays in physical order only if there's a free slot before the head.
+   * Algorithmic complexity = O(1) amortized, the arrays may grow
+   */
+  void insert(T data)
+  {
+    if(ordered_ && empty())
+    {
+      append(data);
+      return;
+    }
+
+    uint32_t next(head_);
+    if(ordered_ && head_ > 0)
+    {
+      --head_;
+    }
+    else
+    {
+      if(ordered_)
+      {
+        // The elements are in [0, size_), the following slots were never used or are free again
+        ordered_ = false;
+        carved_ = size_;
+        freeList_ = NIL;
+      }
+      head_ = createSlot();
+    }
+    values_[head_] = data;
+    next_[head_] = next;
+    ++size_;
+  }
+
+  /**
+   * Append a data element onto the end of the Linked List
+   * Algorithmic complexity = O(1) amortized, the arrays may grow
+   */
+  void append(T data)
+  {
+    uint32_t index;
+    if(ordered_)
+    {
+      if(empty())
+      {
+        head_ = 0;
+      }
+      if(head_ + size_ == capacity_)
+      {
+        makeRoom();
+      }
+      index = head_ + size_;
+    }
+    else
+    {
+      index = createSlot();
+    }
+
+    values_[index] = data;
+    next_[index] = NIL;
+    if(size_ > 0)
+    {
+      next_[tail_] = index;
+    }
+    tail_ = index;
+    ++size_;
+  }
+
+  /**
+   * Remove the element from the head of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    emptyException();
+
+    uint32_t index(head_);
+    head_ = next_[index];
+    if(!ordered_)
+    {
+      next_[index] = freeList_;
+      freeList_ = index;
+    }
+    if(--size_ == 0)
+    {
+      clearLinks();
+    }
+  }
+
+  /**
+   * Remove the element from the tail of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   * Algorithmic complexity = O(1) in physical order, else O(n) to find the penultimate node
+   */
+  void pop_back()
+  {
+    emptyException();
+
+    if(--size_ == 0)
+    {
+      clearLinks();
+      return;
+    }
+
+    uint32_t index(head_);
+    if(ordered_)
+    {
+      index = tail_ - 1;
+    }
+    else
+    {
+      while(next_[index] != tail_)
+      {
+        index = next_[index];
+      }
+      next_[tail_] = freeList_;
+      freeList_ = tail_;
+    }
+    tail_ = index;
+    next_[tail_] = NIL;
+  }
+
+  /**
+   * Return the first element in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &front() { emptyException(); return values_[head_]; }
+  T front() const { emptyException(); return values_[head_]; }
+
+  /**
+   * Return the last element in the Linked List without modifying the list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &back() { emptyException(); return values_[tail_]; }
+  T back() const { emptyException(); return values_[tail_]; }
+
+  /**
+  * Release the LinkedList resources, emptying the list and freeing the arrays
+  */
+  void reset()
+  {
+    ::operator delete(values_);
+    ::operator delete(next_);
+    values_ = NULL;
+    next_ = NULL;
+    capacity_ = 0;
+    clearLinks();
+  }
+
+  /**
+   * Store the elements in list order again, so the scans run SIMD kernels.
+   * Algorithmic complexity = O(n), the arrays are reallocated
+   */
+  void reorder()
+  {
+    if(ordered_)
+    {
+      return;
+    }
+
+    T *values(static_cast<T*>(::operator new(std::size_t(capacity_) * sizeof(T))));
+    uint32_t *next(static_cast<uint32_t*>(::operator new(std::size_t(capacity_) * sizeof(uint32_t))));
+    uint32_t i(0);
+    for(uint32_t index = head_; index != NIL; index = next_[index], ++i)
+    {
+      values[i] = values_[index];
+      next[i] = i + 1;
+    }
+    next[size_ - 1] = NIL;
+
+    ::operator delete(values_);
+    ::operator delete(next_);
+    values_ = values;
+    next_ = next;
+    head_ = 0;
+    tail_ = size_ - 1;
+    ordered_ = true;
+  }
+
+  /**
+   * Return the sum of the elements, 0 if the list is empty.
+   * With floating point elements, the additions may be done in any order.
+   */
+  sum_type sum() const
+  {
+#if defined(SOA_SIMD)
+    if(ordered_)
+    {
+#if defined(SOA_AVX2)
+      if(soaHasAvx2())
+      {
+        return SoaKernelsAvx2<T>::sum(values_ + head_, size_);
+      }
+#endif
+      return SoaKernels<T>::sum(values_ + head_, size_);
+    }
+#endif
+    sum_type total(0);
+    for(uint32_t index = (size_ == 0 ? NIL : head_); index != NIL; index = next_[index])
+    {
+      total += values_[index];
+    }
+    return total;
+  }
+
+  /**
+   * Return the smallest element.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T min() const { return extremum<false>(); }
+
+  /**
+   * Return the largest element.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T max() const { return extremum<true>(); }
+
+  /**
+   * Return the number of elements equal to value
+   */
+  uint32_t count(T value) const
+  {
+#if defined(SOA_SIMD)
+    if(ordered_)
+    {
+#if defined(SOA_AVX2)
+      if(soaHasAvx2())
+      {
+        return SoaKernelsAvx2<T>::count(values_ + head_, size_, value);
+      }
+#endif
+      return SoaKernels<T>::count(values_ + head_, size_, value);
+    }
+#endif
+    uint32_t total(0);
+    for(uint32_t index = (size_ == 0 ? NIL : head_); index != NIL; index = next_[index])
+    {
+      total += (values_[index] == value);
+    }
+    return total;
+  }
+
+  /**
+   * Return an iterator to the first element equal to value, or end() if there's none
+   */
+  iterator find(T value)
+  {
+    if(empty())
+    {
+      return ListIterator();
+    }
+#if defined(SOA_SIMD)
+    if(ordered_)
+    {
+      uint32_t found;
+#if defined(SOA_AVX2)
+      if(soaHasAvx2())
+      {
+        found = SoaKernelsAvx2<T>::find(values_ + head_, size_, value);
+      }
+      else
+#endif
+      {
+        found = SoaKernels<T>::find(values_ + head_, size_, value);
+      }
+      return ListIterator(this, found == size_ ? NIL : head_ + found);
+    }
+#endif
+    uint32_t index(head_);
+    while(index != NIL && values_[index] != value)
+    {
+      index = next_[index];
+    }
+    return ListIterator(this, index);
+  }
+
+private:
+
+  /*
+   * Copying would share the arrays, and the dtor would free them twice
+   */
+  SoaLinkedList(const SoaLinkedList &);
+  SoaLinkedList &operator=(const SoaLinkedList &);
+
+  /**
+   * Internal method to empty the links, an empty list is always in physical order
+   */
+  void clearLinks()
+  {
+    carved_ = 0;
+    freeList_ = NIL;
+    head_ = 0;
+    tail_ = NIL;
+    size_ = 0;
+    ordered_ = true;
+  }
+
+  /**
+   * Internal method to find the smallest element if Max is false, else the largest
+   */
+  template <bool Max>
+  T extremum() const
+  {
+    emptyException();
+#if defined(SOA_SIMD)
+    if(ordered_)
+    {
+#if defined(SOA_AVX2)
+      if(soaHasAvx2())
+      {
+        return Max ? SoaKernelsAvx2<T>::max(values_ + head_, size_) : SoaKernelsAvx2<T>::min(values_ + head_, size_);
+      }
+#endif
+      return SoaKernels<T>::template extremum<Max>(values_ + head_, size_);
+    }
+#endif
+    T result(values_[head_]);
+    for(uint32_t index = next_[head_]; index != NIL; index = next_[index])
+    {
+      result = (Max ? values_[index] > result : values_[index] < result) ? values_[index] : result;
+    }
+    return result;
+  }
+
+  /**
+   * Internal method to take a free slot out of physical order, the arrays grow if there's none
+   */
+  uint32_t createSlot()
+  {
+    if(freeList_ != NIL)
+    {
+      uint32_t index(freeList_);
+      freeList_ = next_[index];
+      return index;
+    }
+
+    if(carved_ == capacity_)
+    {
+      grow(newCapacity(), 0, carved_);
+    }
+    return carved_++;
+  }
+
+  /**
+   * Internal method to make room for appending in physical order: the elements
+   * are moved to the start of the arrays if over half of them is free, else the arrays grow.
+   */
+  void makeRoom()
+  {
+    if(head_ > capacity_ / 2)
+    {
+      std::memmove(values_, values_ + head_, std::size_t(size_) * sizeof(T));
+    }
+    else
+    {
+      grow(newCapacity(), head_, size_);
+    }
+
+    for(uint32_t i = 0; i < size_; ++i)
+    {
+      next_[i] = i + 1;
+    }
+    if(size_ > 0)
+    {
+      next_[size_ - 1] = NIL;
+      tail_ = size_ - 1;
+    }
+    head_ = 0;
+  }
+
+  uint32_t newCapacity() const
+  {
+    if(capacity_ == NIL)
+    {
+      LIST_THROW(std::length_error("the list can't hold more elements"));
+    }
+    return capacity_ < 16 ? 16 : (capacity_ > NIL / 2 ? NIL : capacity_ * 2);
+  }
+
+  /**
+   * Internal method to reallocate the arrays with capacity slots,
+   * copying count slots from first to the start of the new arrays
+   */
+  void grow(uint32_t capacity, uint32_t first, uint32_t count)
+  {
+    T *values(static_cast<T*>(::operator new(std::size_t(capacity) * sizeof(T))));
+    uint32_t *next(static_cast<uint32_t*>(::operator new(std::size_t(capacity) * sizeof(uint32_t))));
+    if(count > 0)
+    {
+      std::memcpy(values, values_ + first, std::size_t(count) * sizeof(T));
+      std::memcpy(next, next_ + first, std::size_t(count) * sizeof(uint32_t));
+    }
+
+    ::operator delete(values_);
+    ::operator delete(next_);
+    values_ = values;
+    next_ = next;
+    capacity_ = capacity;
+  }
+
+  /**
+   * Internal method to check if the Linked List is empty.
+   * Throws a std::length_error exception if it is empty
+   */
+  void emptyException() const
+  {
+    if(empty())
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+  }
+
+  T *values_;
+  uint32_t *next_;
+  uint32_t capacity_;
+  uint32_t carved_;    // out of physical order, number of slots used at least once
+  uint32_t freeList_;  // out of physical order, the free slots below carved_
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t size_;
+  bool ordered_;
+};
+
+#endif /* SOALINKEDLIST_HH_ */
@@ -0,0 +1,234 @@
+/*
+ * SpscLinkedList.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SPSCLINKEDLIST_HH_
+#define SPSCLINKEDLIST_HH_
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <stdint.h>
+
+#include "ListPolicies.hh"
+
+/**
+ * A wait-free single-producer/single-consumer single LinkedList, used as a
+ * FIFO queue between exactly one thread calling append() and exactly one
+ * thread calling pop_front(), try_pop_front(), front() and empty().
+ *
+ * No CAS is needed: head_ always points to a dummy node only the consumer
+ * moves forward, and the producer links new nodes after tail_, which only
+ * it uses. Consumed nodes are not freed, the producer recycles them for
+ * its next appends once it sees the consumer has moved past them.
+ * The producer and consumer fields are kept on separate cache lines.
+ */
+template <class T>
+class SpscLinkedList
+{
+private:
+  /**
+   * Internal class used to store the data in the Linked List
+   */
+  struct ListNode
+  {
+    ListNode() : next_(NULL) {}
+    T *data() { return reinterpret_cast<T*>(&data_); }
+    std::atomic<ListNode*> next_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type data_;
+  };
+
+  static const uint32_t CACHE_LINE = 64;
+
+public:
+  SpscLinkedList() :
+    head_(new ListNode()),
+    popped_(0),
+    tail_(head_.load()),
+    first_(tail_),
+    headCopy_(tail_),
+    appended_(0)
+  {
+  }
+
+  /**
+   * Not thread safe: neither the producer nor the consumer may be using the list
+   */
+  ~SpscLinkedList()
+  {
+    ListNode *head(head_.load());
+    ListNode *node(first_);
+    bool hasData(false);
+    while(node != NULL)
+    {
+      ListNode *next(node->next_.load());
+      if(hasData)
+      {
+        node->data()->~T();
+      }
+      if(node == head)
+      {
+        // Only the nodes following the dummy node hold elements
+        hasData = true;
+      }
+      delete node;
+      node = next;
+    }
+  }
+
+  /**
+   * Return the number of elements in the linked list.
+   * Only approximate when the producer or consumer is modifying the list,
+   * but never wraps below 0.
+   */
+  inline uint32_t size() const
+  {
+    // popped_ first, so that the consumer moving on between the loads can't make it wrap.
+    // The counters themselves wrap, the difference between them doesn't.
+    uint32_t popped(popped_.load(std::memory_order_relaxed));
+    int32_t size(appended_.load(std::memory_order_relaxed) - popped);
+    return size < 0 ? 0 : size;
+  }
+
+  /**
+   * Return true if the list is empty, false otherwise. Consumer only.
+   */
+  bool empty() const
+  {
+    return head_.load(std::memory_order_relaxed)->next_.load(std::memory_order_acquire) == NULL;
+  }
+
+  /**
+   * Append a data node onto the end of the Linked List. Producer only.
+   */
+  void append(const T &data)
+  {
+    ListNode *node(createNode());
+    LIST_TRY
+    {
+      new (node->data()) T(data);
+    }
+    LIST_CATCH_ALL
+    {
+      // Keep the node to be recycled, it's the oldest one
+      node->next_.store(first_, std::memory_order_relaxed);
+      first_ = node;
+      LIST_RETHROW;
+    }
+    node->next_.store(NULL, std::memory_order_relaxed);
+
+    // Counted before it's published, so that it can't be popped and uncounted first
+    appended_.store(appended_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // Publish the node, the consumer can use it as soon as it sees it
+    tail_->next_.store(node, std::memory_order_release);
+    tail_ = node;
+  }
+
+  /**
+   * Move the first element into data and remove it from the Linked List. Consumer only.
+   * Return false, leaving data untouched, if the list is empty.
+   */
+  bool try_pop_front(T &data)
+  {
+    ListNode *head(head_.load(std::memory_order_relaxed));
+    ListNode *next(head->next_.load(std::memory_order_acquire));
+    if(next == NULL)
+    {
+      return false;
+    }
+
+    data = std::move(*next->data());
+    consume(next);
+    return true;
+  }
+
+  /**
+   * Remove the node from the head of the Linked list. Consumer only.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    ListNode *next(head_.load(std::memory_order_relaxed)->next_.load(std::memory_order_acquire));
+    if(next == NULL)
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+
+    consume(next);
+  }
+
+  /**
+   * Return the first element in the Linked List without modifying the list. Consumer only.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  T &front()
+  {
+    ListNode *next(head_.load(std::memory_order_relaxed)->next_.load(std::memory_order_acquire));
+    if(next == NULL)
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+
+    return *next->data();
+  }
+
+private:
+
+  /*
+   * The list can't be copied
+   */
+  SpscLinkedList(const SpscLinkedList &);
+  SpscLinkedList &operator=(const SpscLinkedList &);
+
+  /**
+   * Internal consumer method to destroy the element in next, and make it the new dummy node.
+   * The previous dummy node can then be recycled by the producer.
+   */
+  void consume(ListNode *next)
+  {
+    next->data()->~T();
+    head_.store(next, std::memory_order_release);
+    popped_.store(popped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Internal producer method to get a node, recycling the nodes the consumer is done with.
+   * The consumer is done with all the nodes from first_ up to the current dummy node.
+   */
+  ListNode *createNode()
+  {
+    if(first_ == headCopy_)
+    {
+      // Only look at the consumer cache line when the known recyclable nodes are used up
+      headCopy_ = head_.load(std::memory_order_acquire);
+      if(first_ == headCopy_)
+      {
+        return new ListNode();
+      }
+    }
+
+    ListNode *node(first_);
+    first_ = first_->next_.load(std::memory_order_relaxed);
+    return node;
+  }
+
+  char padding0_[CACHE_LINE];
+
+  // Consumer fields
+  std::atomic<ListNode*> head_;
+  std::atomic<uint32_t> popped_;
+  char padding1_[CACHE_LINE];
+
+  // Producer fields
+  ListNode *tail_;
+  ListNode *first_;
+  ListNode *headCopy_;
+  std::atomic<uint32_t> appended_;
+  char padding2_[CACHE_LINE];
+};
+
+#endif /* SPSCLINKEDLIST_HH_ */
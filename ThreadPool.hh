@@ -0,0 +1,246 @@
+/*
+ * ThreadPool.hh
+ *
+ * Simple pool of worker threads used by the parallel list operations
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef THREADPOOL_HH_
+#define THREADPOOL_HH_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * A fixed pool of worker threads. The calling thread also takes part in
+ * the work, so a pool of size() N has N-1 worker threads.
+ * Any thread may call run(): while the pool is busy with another run(),
+ * including from one of its own tasks, the tasks run on the calling thread.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * Create a pool where numThreads threads, including the caller, run the tasks.
+   * By default, as many threads as hardware threads.
+   */
+  explicit ThreadPool(unsigned numThreads = std::thread::hardware_concurrency()) :
+    task_(NULL),
+    numTasks_(0),
+    nextTask_(0),
+    pending_(0),
+    activeWorkers_(0),
+    generation_(0),
+    busy_(false),
+    stopping_(false)
+  {
+    for(unsigned i = 1; i < numThreads; ++i)
+    {
+      workers_.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wakeWorkers_.notify_all();
+    for(size_t i = 0; i < workers_.size(); ++i)
+    {
+      workers_[i].join();
+    }
+  }
+
+  /**
+   * Return the number of threads running the tasks, including the caller
+   */
+  unsigned size() const { return workers_.size() + 1; }
+
+  /**
+   * Run task(i) for every i in [0, numTasks) on the pool threads, and return
+   * once they are all done. If tasks throw, the first exception is rethrown.
+   * If the pool is busy, with a run() from another thread or a nested one
+   * from a task, the tasks run on the calling thread instead.
+   */
+  void run(size_t numTasks, const std::function<void(size_t)> &task)
+  {
+    if(numTasks == 0)
+    {
+      return;
+    }
+
+    bool idle(false);
+    if(!busy_.compare_exchange_strong(idle, true))
+    {
+      // Waiting for the pool could deadlock a nested run(), so it's not shared
+      runInline(numTasks, task);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      numTasks_ = numTasks;
+      nextTask_.store(0);
+      pending_ = numTasks;
+      error_ = std::exception_ptr();
+      ++generation_;
+    }
+    wakeWorkers_.notify_all();
+
+    runTasks();
+
+    // Also wait for the workers to leave runTasks(), so none can see the next run() half set up
+    std::unique_lock<std::mutex> lock(mutex_);
+    tasksDone_.wait(lock, [this]() { return pending_ == 0 && activeWorkers_ == 0; });
+    task_ = NULL;
+    busy_.store(false);
+    if(error_)
+    {
+      std::rethrow_exception(error_);
+    }
+  }
+
+  /**
+   * Return a pool shared by all the parallel list operations
+   */
+  static ThreadPool &instance()
+  {
+    static ThreadPool pool;
+    return pool;
+  }
+
+private:
+
+  /*
+   * The pool can't be copied
+   */
+  ThreadPool(const ThreadPool &);
+  ThreadPool &operator=(const ThreadPool &);
+
+  /**
+   * Internal method to run tasks until there are none left to start
+   */
+  void runTasks()
+  {
+    size_t done(0);
+    size_t index;
+    while((index = nextTask_.fetch_add(1)) < numTasks_)
+    {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+      try
+      {
+        (*task_)(index);
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(!error_)
+        {
+          error_ = std::current_exception();
+        }
+      }
+#else
+      (*task_)(index);
+#endif
+      ++done;
+    }
+
+    if(done > 0)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_ -= done;
+    }
+  }
+
+  /**
+   * Internal method to run all the tasks on the calling thread, when the pool is busy
+   */
+  static void runInline(size_t numTasks, const std::function<void(size_t)> &task)
+  {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+    std::exception_ptr error;
+    for(size_t index = 0; index < numTasks; ++index)
+    {
+      try
+      {
+        task(index);
+      }
+      catch(...)
+      {
+        if(!error)
+        {
+          error = std::current_exception();
+        }
+      }
+    }
+    if(error)
+    {
+      std::rethrow_exception(error);
+    }
+#else
+    for(size_t index = 0; index < numTasks; ++index)
+    {
+      task(index);
+    }
+#endif
+  }
+
+  /**
+   * Internal method run by the worker threads, waiting for each new run()
+   */
+  void workerLoop()
+  {
+    uint64_t seenGeneration(0);
+    for(;;)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wakeWorkers_.wait(lock, [this, seenGeneration]() { return stopping_ || generation_ != seenGeneration; });
+        if(stopping_)
+        {
+          return;
+        }
+        seenGeneration = generation_;
+        if(task_ == NULL)
+        {
+          // Woke up after the run() was already over
+          continue;
+        }
+        ++activeWorkers_;
+      }
+
+      runTasks();
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      --activeWorkers_;
+      tasksDone_.notify_all();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wakeWorkers_;
+  std::condition_variable tasksDone_;
+  const std::function<void(size_t)> *task_;
+  size_t numTasks_;
+  std::atomic<size_t> nextTask_;
+  size_t pending_;
+  unsigned activeWorkers_;
+  uint64_t generation_;
+  std::atomic<bool> busy_;    // a run() is using the worker threads
+  bool stopping_;
+  std::exception_ptr error_;
+};
+
+#endif /* THREADPOOL_HH_ */
@@ -0,0 +1,333 @@
+/*
+ * UnrolledLinkedList.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef UNROLLEDLINKEDLIST_HH_
+#define UNROLLEDLINKEDLIST_HH_
+
+#include <stdexcept>
+#include <new>
+#include <type_traits>
+#include <stdint.h>
+
+#include "NodeAllocator.hh"
+#include "ListPolicies.hh"
+
+/**
+ * An unrolled single LinkedList: each node stores up to NodeCapacity
+ * elements contiguously, along with a per-node element count. It has the
+ * same interface as the SimpleLinkedList, but sequential iteration only
+ * follows a pointer every NodeCapacity elements, and the link overhead
+ * per element is divided by NodeCapacity.
+ */
+template <class T, uint32_t NodeCapacity = 16, class Allocator = HeapAllocator<T> >
+class UnrolledLinkedList
+{
+private:
+  /**
+   * Internal class used to store a chunk of data in the Linked List.
+   * The elements in use are the slots [first_, first_ + count_)
+   */
+  struct ListNode
+  {
+    ListNode() : next_(NULL), first_(0), count_(0) {}
+    T *at(uint32_t index) { return reinterpret_cast<T*>(&data_[index]); }
+    ListNode *next_;
+    uint32_t first_;
+    uint32_t count_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type data_[NodeCapacity];
+  };
+
+  /**
+   * Internal class used to iterate the Linked List
+   */
+  class ListIterator
+  {
+  public:
+    ListIterator() : node_(NULL), index_(0) {}
+    ListIterator(ListNode *node, uint32_t index) : node_(node), index_(index) {}
+    bool operator==(ListIterator rhs) const { return rhs.node_ == node_ && rhs.index_ == index_; }
+    bool operator!=(ListIterator rhs) const { return !(*this == rhs); }
+    T * operator->() { return node_->at(index_); }
+    T const * operator->() const { return node_->at(index_); }
+    T & operator*()  { return *(node_->at(index_)); }
+    T operator*() const { return *(node_->at(index_)); }
+    void increment()
+    {
+      if(++index_ == node_->first_ + node_->count_)
+      {
+        node_ = node_->next_;
+        index_ = (node_ == NULL ? 0 : node_->first_);
+      }
+    }
+    ListIterator &operator++() { increment(); return *this; }
+    ListIterator operator++(int unused) { ListIterator retval(*this); increment(); return retval; }
+  private:
+    ListNode *node_;
+    uint32_t index_;
+  };
+
+public:
+  typedef ListIterator iterator;
+  typedef ListIterator const_iterator;
+  typedef typename Allocator::template rebind<ListNode>::other node_allocator_type;
+
+  UnrolledLinkedList() :
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+  }
+
+  explicit UnrolledLinkedList(const node_allocator_type &allocator) :
+    allocator_(allocator),
+    head_(NULL),
+    tail_(NULL),
+    size_(0)
+  {
+  }
+
+  ~UnrolledLinkedList()
+  {
+    reset();
+  }
+
+  /**
+   * Return an iterator to the beginning of the Linked List.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator begin() { emptyException(); return ListIterator(head_, head_->first_); }
+  const_iterator begin() const { emptyException(); return ListIterator(head_, head_->first_); }
+
+  /**
+   * Return an iterator indicating the end of the Linked List has been reached
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  iterator end() { emptyException(); return ListIterator(); }
+  const_iterator end() const { emptyException(); return ListIterator(); }
+
+  /**
+   * Return the number of elements in the linked list
+   */
+  inline uint32_t size() const { return size_; }
+
+  /**
+   * Return true if the list is empty, false otherwise
+   */
+  inline bool empty() const { return size_ == 0; }
+
+  /**
+   * Insert a data element into the head of the Linked List.
+   * A new node is only needed when the head node has no free slot before its first element.
+   */
+  void insert(const T &data)
+  {
+    if(head_ != NULL && head_->first_ > 0)
+    {
+      new (head_->at(head_->first_ - 1)) T(data);
+      --head_->first_;
+      ++head_->count_;
+      ++size_;
+      return;
+    }
+
+    // Fill new head nodes from the back, so the following inserts use the same node
+    ListNode *node(createNode(NodeCapacity - 1, data));
+    node->next_ = head_;
+    head_ = node;
+    if(tail_ == NULL)
+    {
+      tail_ = node;
+    }
+    ++size_;
+  }
+
+  /**
+   * Append a data element onto the end of the Linked List
+   * A new node is only needed when the tail node has no free slot after its last element.
+   */
+  void append(const T &data)
+  {
+    if(tail_ != NULL && tail_->first_ + tail_->count_ < NodeCapacity)
+    {
+      new (tail_->at(tail_->first_ + tail_->count_)) T(data);
+      ++tail_->count_;
+      ++size_;
+      return;
+    }
+
+    ListNode *node(createNode(0, data));
+    if(tail_ == NULL)
+    {
+      head_ = node;
+    }
+    else
+    {
+      tail_->next_ = node;
+    }
+    tail_ = node;
+    ++size_;
+  }
+
+  /**
+   * Remove the element from the head of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  void pop_front()
+  {
+    emptyException();
+
+    head_->at(head_->first_)->~T();
+    ++head_->first_;
+    --size_;
+
+    if(--head_->count_ == 0)
+    {
+      ListNode *node(head_->next_);
+      destroyNode(head_);
+      head_ = node;
+      if(head_ == NULL)
+      {
+        tail_ = NULL;
+      }
+    }
+  }
+
+  /**
+   * Remove the element from the tail of the Linked list
+   * If the list is empty, an std::length_error exception will be thrown.
+   * Only when the tail node becomes empty are the nodes walked to find its predecessor.
+   */
+  void pop_back()
+  {
+    emptyException();
+
+    tail_->at(tail_->first_ + tail_->count_ - 1)->~T();
+    --size_;
+
+    if(--tail_->count_ > 0)
+    {
+      return;
+    }
+
+    if(head_ == tail_)
+    {
+      destroyNode(tail_);
+      head_ = tail_ = NULL;
+      return;
+    }
+
+    // Iterate to the penultimate node
+    ListNode *node(head_);
+    while(node->next_ != tail_)
+    {
+      node = node->next_;
+    }
+    destroyNode(tail_);
+    tail_ = node;
+    tail_->next_ = NULL;
+  }
+
+  /**
+  * Release the LinkedList resources, emptying the list
+  */
+  void reset()
+  {
+    bool bulkRelease(allocator_.can_release());
+    ListNode *node(head_);
+    while(node != NULL)
+    {
+      ListNode *next(node->next_);
+      if(!std::is_trivially_destructible<T>::value)
+      {
+        for(uint32_t i = node->first_; i < node->first_ + node->count_; ++i)
+        {
+          node->at(i)->~T();
+        }
+      }
+      if(!bulkRelease)
+      {
+        destroyNode(node);
+      }
+      node = next;
+    }
+
+    if(bulkRelease)
+    {
+      allocator_.release();
+    }
+    head_ = tail_ = NULL;
+    size_ = 0;
+  }
+
+  /**
+   * Return the first element in the Linked List without modifying the list.
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  inline T front() { emptyException(); return *(head_->at(head_->first_)); }
+
+  /**
+   * Return the last element in the Linked List without modifying the list
+   * If the list is empty, an std::length_error exception will be thrown.
+   */
+  inline T back() { emptyException(); return *(tail_->at(tail_->first_ + tail_->count_ - 1)); }
+
+private:
+
+  /*
+   * Copying would share the nodes, and the dtor would free them twice
+   */
+  UnrolledLinkedList(const UnrolledLinkedList &);
+  UnrolledLinkedList &operator=(const UnrolledLinkedList &);
+
+  /**
+   * Internal method to allocate a node holding just data, stored in the slot first
+   */
+  ListNode *createNode(uint32_t first, const T &data)
+  {
+    ListNode *node(new (allocator_.allocate()) ListNode());
+    LIST_TRY
+    {
+      new (node->at(first)) T(data);
+    }
+    LIST_CATCH_ALL
+    {
+      destroyNode(node);
+      LIST_RETHROW;
+    }
+    node->first_ = first;
+    node->count_ = 1;
+
+    return node;
+  }
+
+  /**
+   * Internal method to deallocate a node, its elements must already be destroyed
+   */
+  void destroyNode(ListNode *node)
+  {
+    node->~ListNode();
+    allocator_.deallocate(node);
+  }
+
+  /**
+   * Internal method to check if the Linked List is empty.
+   * Throws a std::length_error exception if it is empty
+   */
+  void emptyException() const
+  {
+    if(empty())
+    {
+      LIST_THROW(std::length_error("the list is empty"));
+    }
+  }
+
+  node_allocator_type allocator_;
+  ListNode *head_;
+  ListNode *tail_;
+  uint32_t size_;
+};
+
+#endif /* UNROLLEDLINKEDLIST_HH_ */